@@ -1,20 +1,890 @@
-import unittest
-
-# noinspection PyUnresolvedReferences
-from dotnet import *
-
-
-# noinspection PyUnresolvedReferences
-class TestImportMachinery(unittest.TestCase):
-
-    def setUp(self):
-        pass
-
-    def test_from_imports(self):
-
-        from System import Int32
-        self.assertEqual(Int32.Parse("123"), 123)
-
-
-if __name__ == '__main__':
-    unittest.main()
+import array
+import math
+import os
+import struct
+import sys
+import tempfile
+import threading
+import unittest
+import weakref
+
+# noinspection PyUnresolvedReferences
+from dotnet import *
+
+
+FIXTURE_SOURCE = """
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+
+namespace PyDotnetTest {
+
+    public static class Fixture {
+
+        public static int Sum11(int a1, int a2, int a3, int a4, int a5, int a6, int a7, int a8, int a9, int a10, int a11) {
+            return a1 + a2 + a3 + a4 + a5 + a6 + a7 + a8 + a9 + a10 + a11;
+        }
+
+        public static int Twice(int x) {
+            return 2 * x;
+        }
+
+        public static string Twice(string x) {
+            return x + x;
+        }
+
+        public static string Describe(char x) {
+            return "char";
+        }
+
+        public static string Describe(string x) {
+            return "string";
+        }
+
+        public static int CharCode(char x) {
+            return x;
+        }
+
+        public static string Optional(int a, int b = 2, string c = "x") {
+            return a + ":" + b + ":" + c;
+        }
+
+        public static string OptionalNoDefault(int a, [Optional] object b, [Optional] int c) {
+            return a + ":" + (b == Type.Missing ? "missing" : b) + ":" + c;
+        }
+
+        public static bool TryDouble(int x, out int doubled) {
+            doubled = 2 * x;
+            return x >= 0;
+        }
+    }
+
+    public delegate bool TryParser(string text, out int value);
+
+    public delegate int Handler11(int a1, int a2, int a3, int a4, int a5, int a6, int a7, int a8, int a9, int a10, int a11);
+
+    public static class Callbacks {
+
+        public static string Parse(TryParser parser, string text) {
+            int value;
+            return parser(text, out value) ? "parsed:" + value : "failed";
+        }
+
+        public static int Call11(Handler11 handler) {
+            return handler(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11);
+        }
+
+        public static string CallMixed(Func<string, bool, int?, object, double, string> f) {
+            return f("a", true, 7, 8, 1.5);
+        }
+
+        public static int CallOnWorker(Func<int, int> f, int x) {
+            int result = 0;
+            System.Threading.Thread worker = new System.Threading.Thread(() => { result = f(x); });
+            worker.Start();
+            worker.Join();
+            return result;
+        }
+    }
+
+    public static class Arrays {
+
+        public static sbyte[] SByte(sbyte[] x) { return x; }
+        public static byte[] Byte(byte[] x) { return x; }
+        public static short[] Int16(short[] x) { return x; }
+        public static ushort[] UInt16(ushort[] x) { return x; }
+        public static int[] Int32(int[] x) { return x; }
+        public static uint[] UInt32(uint[] x) { return x; }
+        public static long[] Int64(long[] x) { return x; }
+        public static ulong[] UInt64(ulong[] x) { return x; }
+        public static float[] Single(float[] x) { return x; }
+        public static double[] Double(double[] x) { return x; }
+
+        public static string Shape(int[,] x) {
+            return x.GetLength(0) + "x" + x.GetLength(1) + ":" + x[1, 0];
+        }
+    }
+
+    public static class Collections {
+
+        public static string JoinList(List<int> x) {
+            return x.GetType().Name + ":" + string.Join(",", x);
+        }
+
+        public static string JoinEnumerable(IEnumerable<int> x) {
+            return x.GetType().Name + ":" + string.Join(",", x);
+        }
+
+        public static IEnumerable<int> Count(int n) {
+            for (int i = 0; i < n; ++i) {
+                yield return i;
+            }
+        }
+
+        public static double SumDoubles(List<double> x) {
+            double sum = 0;
+            foreach (double item in x) {
+                sum += item;
+            }
+            return sum;
+        }
+
+        public static string JoinDictionary(Dictionary<string, int> x) {
+            List<string> keys = new List<string>(x.Keys);
+            keys.Sort(StringComparer.Ordinal);
+            List<string> items = new List<string>();
+            foreach (string key in keys) {
+                items.Add(key + "=" + x[key]);
+            }
+            return x.GetType().Name + ":" + string.Join(",", items);
+        }
+    }
+
+    public static class Views {
+
+        public static string Describe(IList<int> x) {
+            return x.GetType().Name + ":" + x.Count;
+        }
+
+        public static int ItemAt(IList<int> x, int index) {
+            return x[index];
+        }
+
+        public static string ErrorAt(IReadOnlyList<int> x, int index) {
+            try {
+                return x[index].ToString();
+            } catch (Exception e) {
+                return e.GetType().Name;
+            }
+        }
+
+        public static int Sum(IEnumerable<int> x) {
+            int sum = 0;
+            foreach (int item in x) {
+                sum += item;
+            }
+            return sum;
+        }
+
+        public static string DescribeMapping(IReadOnlyDictionary<string, int> x) {
+            return x.GetType().Name + ":" + x.Count;
+        }
+
+        public static int Lookup(IReadOnlyDictionary<string, int> x, string key) {
+            int value;
+            return x.TryGetValue(key, out value) ? value : -1;
+        }
+    }
+
+    public class Point {
+
+        public int X;
+
+        public int Y { get; set; }
+
+        public string Name { get; set; }
+
+        public int Broken {
+            get { throw new InvalidOperationException("broken"); }
+        }
+
+        public Point(int x, int y) {
+            X = x;
+            Y = y;
+        }
+
+        public int Sum() {
+            return X + Y;
+        }
+    }
+}
+"""
+
+__fixture_built = False
+
+# Array module type code, method of PyDotnetTest.Arrays, and range of integer item kinds
+KERNEL_KINDS = (
+    ('b', 'SByte', -2 ** 7, 2 ** 7 - 1),
+    ('B', 'Byte', 0, 2 ** 8 - 1),
+    ('h', 'Int16', -2 ** 15, 2 ** 15 - 1),
+    ('H', 'UInt16', 0, 2 ** 16 - 1),
+    ('i', 'Int32', -2 ** 31, 2 ** 31 - 1),
+    ('I', 'UInt32', 0, 2 ** 32 - 1),
+    ('q', 'Int64', -2 ** 63, 2 ** 63 - 1),
+    ('Q', 'UInt64', 0, 2 ** 64 - 1),
+    ('f', 'Single', None, None),
+    ('d', 'Double', None, None),
+)
+
+KERNEL_INSTRUCTION_SETS = ('scalar', 'sse2', 'avx2')
+
+# Odd length, so that vector loops also leave items for their scalar tails
+KERNEL_RUN_LENGTH = 37
+
+KERNEL_OVERFLOW = 'overflow'
+
+
+def build_fixture():
+    """Compiles types used by tests into in-memory assembly, once per process."""
+    global __fixture_built
+    if not __fixture_built:
+        output = os.path.join(tempfile.gettempdir(), 'PyDotnetTest%d.dll' % os.getpid())
+        build_assembly(FIXTURE_SOURCE, output, [], '')
+        __fixture_built = True
+
+
+# noinspection PyUnresolvedReferences
+class TestImportMachinery(unittest.TestCase):
+
+    def setUp(self):
+        pass
+
+    def test_from_imports(self):
+
+        from System import Int32
+        self.assertEqual(Int32.Parse("123"), 123)
+
+    def test_value_type_conversions(self):
+
+        from System import Decimal, Char
+        self.assertEqual(Decimal.Add(1, 2.5).ToString(), "3.5")
+        self.assertTrue(Char.IsDigit("7"))
+
+    def test_compiled_invokers_match_reflection(self):
+
+        from dotnet import PyDotnet
+        from System import DateTime, Int32, String
+        callable_type = PyDotnet.Interop.Callable
+        compiled = callable_type.__compiledinvokers__
+        results = []
+        try:
+            for enabled in (True, False):
+                callable_type.__compiledinvokers__ = enabled
+                with self.assertRaises(Exception) as error:
+                    Int32.Parse("abc")
+                results.append((
+                    DateTime.Compare(None, None),
+                    String.Equals("a", "A", 5),
+                    str(error.exception).splitlines()[0]))
+        finally:
+            callable_type.__compiledinvokers__ = compiled
+        self.assertEqual(results[0], results[1])
+        self.assertEqual(results[0][:2], (0, True))
+        self.assertIn("TargetInvocationException", results[0][2])
+
+    def test_lazy_views(self):
+
+        from System import String
+        self.assertEqual(String.Join(",", view(["a", "b", "c"])), "a,b,c")
+
+    def test_callback_conversion(self):
+
+        from System import Int32
+        from System.Collections.Generic import List
+        lst = List[Int32]()
+        lst.AddRange([1, 2, 3, 4, 5, 6])
+        self.assertEqual(lst.FindIndex(lambda x: x > 3), 3)
+        self.assertEqual(lst.FindIndex(lambda x: x > 5), 5)
+        self.assertEqual(lst.FindAll(lambda x: x % 2 == 0).Count, 3)
+        self.assertTrue(lst.TrueForAll(lambda x: x > 0))
+
+    def test_callback_conversion_through_proxy_methods(self):
+
+        from dotnet import PyDotnet
+        callable_type = PyDotnet.Interop.Callable
+        compiled = callable_type.__compiledinvokers__
+        try:
+            callable_type.__compiledinvokers__ = False
+            self.test_callback_conversion()
+        finally:
+            callable_type.__compiledinvokers__ = compiled
+
+    def test_callback_references_released(self):
+
+        from dotnet import PyDotnet
+        from System import GC, Int32
+        from System.Collections.Generic import List
+
+        def collect():
+            GC.Collect()
+            GC.WaitForPendingFinalizers()
+            # Releases queued by finalizers are drained once this call takes back the GIL
+            GC.Collect()
+
+        lst = List[Int32]()
+        lst.AddRange([1, 2, 3])
+        collect()
+        start = PyDotnet.Interop.stats()['python_references']
+        for i in range(10):
+            self.assertEqual(lst.FindIndex(lambda x: x > i), i if i < 3 else -1)
+        collect()
+        stats = PyDotnet.Interop.stats()
+        self.assertEqual(stats['python_references_pending'], 0)
+        self.assertEqual(stats['python_references'], start)
+
+    def test_queued_events(self):
+
+        from System import Int32
+        from System.Collections.ObjectModel import ObservableCollection
+        coll = ObservableCollection[Int32]()
+        received = []
+        handler = lambda sender, args: received.append(sender.Count)
+        queue = event_queue(16)
+        coll.CollectionChanged += queue.bind(handler)
+        coll.Add(5)
+        self.assertEqual(received, [])
+        self.assertEqual(queue.pending, 1)
+        self.assertEqual(queue.dispatch(), 1)
+        self.assertEqual(received, [1])
+        coll.CollectionChanged -= queue.bind(handler)
+        coll.Add(6)
+        self.assertEqual(queue.pending, 0)
+        self.assertEqual(queue.dropped, 0)
+
+    def test_bound_method_events(self):
+
+        from System import Int32
+        from System.Collections.ObjectModel import ObservableCollection
+
+        class Listener(object):
+            def __init__(self):
+                self.received = []
+
+            def on_changed(self, sender, args):
+                self.received.append(sender.Count)
+
+        coll = ObservableCollection[Int32]()
+        listener = Listener()
+        coll.CollectionChanged += listener.on_changed
+        coll.Add(5)
+        self.assertEqual(listener.received, [1])
+        # Each attribute access creates new bound method, which must still match
+        coll.CollectionChanged -= listener.on_changed
+        coll.Add(6)
+        self.assertEqual(listener.received, [1])
+
+        def remove():
+            coll.CollectionChanged -= listener.on_changed
+        self.assertRaises(ValueError, remove)
+
+        queue = event_queue(16)
+        coll.CollectionChanged += queue.bind(listener.on_changed)
+        coll.CollectionChanged -= queue.bind(listener.on_changed)
+        coll.Add(7)
+        self.assertEqual(queue.pending, 0)
+
+    def test_identity_map(self):
+
+        from dotnet import PyDotnet
+        from System import Object
+        from System.Collections.Generic import List
+        lst = List[Object]()
+        lst.Add(Object())
+        object_type = PyDotnet.Interop.Object
+        identitymap = object_type.__identitymap__
+        try:
+            object_type.__identitymap__ = True
+            item = lst[0]
+            self.assertIs(lst[0], item)
+            ref = weakref.ref(item)
+            del item
+            self.assertIsNone(ref())
+        finally:
+            object_type.__identitymap__ = identitymap
+
+    def test_handle_scope(self):
+
+        from dotnet import PyDotnet
+        from System import Version
+        from System.Collections.Generic import List
+        interop = PyDotnet.Interop
+        lst = List[Version]()
+        lst.Add(Version(1, 2))
+        with interop.scope() as scope:
+            item = lst[0]
+            self.assertEqual(scope.count, 1)
+            self.assertEqual(str(item), '1.2')
+            method = item.CompareTo
+            self.assertEqual(method(lst[0]), 0)
+            handles = interop.stats()['handles']
+        self.assertGreater(scope.released, 1)
+        self.assertLess(interop.stats()['handles'], handles)
+        # Wrapper and bound method kept past the scope hold null, while list still holds the object
+        self.assertEqual(str(item), 'System.Version')
+        self.assertRaises(Exception, lambda: item.Major)
+        self.assertRaises(Exception, lambda: method(lst[0]))
+        self.assertEqual(lst.Count, 1)
+        self.assertEqual(lst[0].Major, 1)
+
+    def test_handle_scope_dropped(self):
+
+        from dotnet import PyDotnet
+        from System import Version
+        from System.Collections.Generic import List
+        interop = PyDotnet.Interop
+        lst = List[Version]()
+        lst.Add(Version(1, 2))
+        scope = interop.scope()
+        scope.__enter__()
+        del scope
+        # Scope dropped without __exit__ must not record objects returned after it
+        item = lst[0]
+        with interop.scope() as other:
+            self.assertEqual(other.count, 0)
+        self.assertEqual(str(item), '1.2')
+
+    def test_interop_stats(self):
+
+        from dotnet import PyDotnet
+        from System import Object
+        interop = PyDotnet.Interop
+        stats = interop.stats()
+        self.assertGreaterEqual(stats['handles_peak'], stats['handles'])
+        self.assertGreater(stats['member_descriptors'], 0)
+        interop.__handlesites__ = True
+        try:
+            item = Object()
+            sites = interop.stats()['handle_sites']
+            self.assertTrue(any('test_interop_stats' in site for site in sites))
+        finally:
+            interop.__handlesites__ = False
+
+    def test_handle_slots_reused(self):
+
+        from dotnet import PyDotnet
+        from System import Object
+        interop = PyDotnet.Interop
+        items = [Object() for _ in range(100)]
+        del items
+        slots = interop.stats()['handle_slots']
+        for _ in range(20):
+            items = [Object() for _ in range(100)]
+            self.assertGreaterEqual(interop.stats()['handles'], 100)
+            del items
+            self.assertEqual(interop.stats()['handle_slots'], slots)
+
+    def test_batched_iteration(self):
+
+        from System import BitConverter
+        expected = list(bytearray(struct.pack("<d", 1.5)))
+        self.assertEqual(list(BitConverter.GetBytes(1.5)), expected)
+        iterator_type = type(iter(BitConverter.GetBytes(1.5)))
+        batchsize = iterator_type.__batchsize__
+        self.assertEqual(batchsize, 1)
+        try:
+            iterator_type.__batchsize__ = 3
+            self.assertEqual(list(BitConverter.GetBytes(1.5)), expected)
+            # Large batches of lazy enumerable are pulled with the GIL released
+            from PyDotnetTest import Collections
+            iterator_type.__batchsize__ = 64
+            self.assertEqual(list(Collections.Count(100)), list(range(100)))
+        finally:
+            iterator_type.__batchsize__ = batchsize
+
+    @unittest.skipIf(sys.version_info[0] < 3, "str is not unicode in Python 2")
+    def test_unicode_strings(self):
+
+        from System import String
+        self.assertEqual(String.Concat(u"za\u017c", u"\u00f3\u0142\u0107"), u"za\u017c\u00f3\u0142\u0107")
+        self.assertEqual(String.Concat(u"\U0001F600", u"!"), u"\U0001F600!")
+
+    @unittest.skipIf(sys.version_info[0] < 3, "buffer protocol requires Python 3")
+    def test_array_buffer(self):
+
+        from System import BitConverter
+        view = memoryview(BitConverter.GetBytes(1.5))
+        self.assertEqual(view.format, "B")
+        self.assertEqual(view.tobytes(), struct.pack("<d", 1.5))
+
+    @unittest.skipIf(sys.version_info[0] < 3, "buffer protocol requires Python 3")
+    def test_only_arrays_export_buffers(self):
+
+        from dotnet import PyDotnet
+        from System import BitConverter, Int32, Object
+        from System.Collections.Generic import List
+        self.assertIsInstance(BitConverter.GetBytes(1.5), PyDotnet.Interop.Array)
+        # Objects other than arrays do not claim buffer protocol, so consumers take their non-buffer path
+        self.assertNotIsInstance(List[Int32](), PyDotnet.Interop.Array)
+        self.assertRaises(TypeError, memoryview, List[Int32]())
+        self.assertRaises(TypeError, memoryview, Object())
+
+    @unittest.skipIf(sys.version_info[0] < 3, "buffer protocol requires Python 3")
+    def test_buffer_to_array(self):
+
+        from System import BitConverter
+        self.assertEqual(BitConverter.ToDouble(struct.pack("<d", 2.5), 0), 2.5)
+        self.assertEqual(BitConverter.ToInt32(array.array("i", [7, 0, 0, 0]), 0), 7)
+        self.assertRaises(OverflowError, BitConverter.ToInt32, array.array("i", [256, 0, 0, 0]), 0)
+
+
+# noinspection PyUnresolvedReferences
+class TestFixtureTypes(unittest.TestCase):
+
+    @classmethod
+    def setUpClass(cls):
+        build_fixture()
+
+    def test_call_past_old_arity_limit(self):
+
+        from PyDotnetTest import Fixture
+        self.assertEqual(Fixture.Sum11(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11), 66)
+
+    def test_overload_cache_info(self):
+
+        from PyDotnetTest import Fixture
+        before = Fixture.Twice.__cacheinfo__
+        self.assertEqual(Fixture.Twice(2), 4)
+        self.assertEqual(Fixture.Twice(3), 6)
+        self.assertEqual(Fixture.Twice("ab"), "abab")
+        self.assertEqual(Fixture.Twice("cd"), "cdcd")
+        after = Fixture.Twice.__cacheinfo__
+        self.assertEqual(after['misses'] - before['misses'], 2)
+        self.assertEqual(after['hits'] - before['hits'], 2)
+        self.assertEqual(after['size'], 2)
+
+    def test_char_and_string_overloads(self):
+
+        from PyDotnetTest import Fixture
+        self.assertEqual(Fixture.Describe("abc"), "string")
+        self.assertEqual(Fixture.Describe("a"), "string")
+        self.assertEqual(Fixture.CharCode("a"), 97)
+        self.assertRaises(Exception, Fixture.CharCode, "ab")
+        self.assertEqual(Fixture.CharCode("b"), 98)
+
+    def test_callback_with_out_parameter(self):
+
+        from PyDotnetTest import Callbacks
+
+        def parser(text, value):
+            self.assertEqual(value, 0)
+            return (True, int(text) * 2) if text.isdigit() else (False, 0)
+
+        self.assertEqual(Callbacks.Parse(parser, "21"), "parsed:42")
+        self.assertEqual(Callbacks.Parse(parser, "x"), "failed")
+
+    def test_callback_past_old_arity_limit(self):
+
+        from PyDotnetTest import Callbacks
+        self.assertEqual(Callbacks.Call11(lambda *args: sum(args) * 10), 660)
+        self.assertEqual(Callbacks.Call11(lambda *args: len(args)), 11)
+
+    def test_callback_argument_conversions(self):
+
+        from PyDotnetTest import Callbacks
+        self.assertEqual(Callbacks.CallMixed(lambda *args: "|".join(map(str, args))), "a|True|7|8|1.5")
+
+    def test_call_plan_arguments(self):
+
+        from PyDotnetTest import Fixture
+        self.assertEqual(Fixture.Optional(1), "1:2:x")
+        self.assertEqual(Fixture.Optional(1, 5), "1:5:x")
+        self.assertEqual(Fixture.Optional(1, 5, "y"), "1:5:y")
+        # Optional parameters without default get Type.Missing if they are objects, and default of their type otherwise
+        self.assertEqual(Fixture.OptionalNoDefault(1), "1:missing:0")
+        self.assertEqual(Fixture.OptionalNoDefault(1, "z", 3), "1:z:3")
+        self.assertEqual(list(Fixture.TryDouble(4)), [8, True])
+        self.assertEqual(list(Fixture.TryDouble(-3)), [-6, False])
+        self.assertRaises(Exception, Fixture.Optional)
+        self.assertRaises(Exception, Fixture.Optional, 1, 2, "y", 4)
+
+    @unittest.skipIf(sys.version_info[0] < 3, "switch interval requires Python 3")
+    def test_callbacks_keeping_gil(self):
+
+        from System import Int32
+        from System.Collections.Generic import List
+        lst = List[Int32]()
+        lst.AddRange([1, 2, 3])
+        self.assertFalse(lst.ForEach.__keepgil__)
+        log = []
+        started = threading.Event()
+
+        def other():
+            started.wait()
+            log.append('other')
+
+        def callback(x):
+            started.set()
+            log.append(x)
+
+        thread = threading.Thread(target=other)
+        thread.start()
+        interval = sys.getswitchinterval()
+        try:
+            sys.setswitchinterval(5.0)
+            lst.ForEach.__keepgil__ = True
+            self.assertTrue(lst.ForEach.__keepgil__)
+            self.assertFalse(lst.FindIndex.__keepgil__)
+            # Other thread cannot take the GIL between callbacks, as call does not release it
+            lst.ForEach(callback)
+            thread.join()
+        finally:
+            lst.ForEach.__keepgil__ = False
+            sys.setswitchinterval(interval)
+        self.assertEqual(log, [1, 2, 3, 'other'])
+
+    def test_callbacks_from_other_thread(self):
+
+        from PyDotnetTest import Callbacks
+        # GIL is released for calls not opted in, so that callback run on worker thread can take it
+        self.assertFalse(Callbacks.CallOnWorker.__keepgil__)
+        self.assertEqual(Callbacks.CallOnWorker(lambda x: x + 1, 41), 42)
+
+    def with_compiled_invokers(self, call):
+        """Returns results of call with compiled invokers on and off."""
+        from dotnet import PyDotnet
+        callable_type = PyDotnet.Interop.Callable
+        compiled = callable_type.__compiledinvokers__
+        results = []
+        try:
+            for enabled in (True, False):
+                callable_type.__compiledinvokers__ = enabled
+                results.append(call())
+        finally:
+            callable_type.__compiledinvokers__ = compiled
+        return results
+
+    def test_collection_builders(self):
+
+        from PyDotnetTest import Collections
+        results = self.with_compiled_invokers(lambda: (
+            Collections.JoinList([1, 2, 3]),
+            Collections.JoinEnumerable([4, 5]),
+            Collections.JoinList([]),
+            Collections.JoinDictionary({'b': 2, 'a': 1}),
+            Collections.SumDoubles([1, 2.5])))
+        self.assertEqual(results, [("List`1:1,2,3", "List`1:4,5", "List`1:", "Dictionary`2:a=1,b=2", 3.5)] * 2)
+        # Items are converted into typed array, which still rejects items of other types
+        self.assertRaises(Exception, Collections.JoinList, [1, 'x'])
+        self.assertRaises(Exception, Collections.JoinDictionary, {'a': 'x'})
+
+    @unittest.skipIf(sys.version_info[0] < 3, "buffer protocol requires Python 3")
+    def test_buffer_collection_builders(self):
+
+        from PyDotnetTest import Collections
+        results = self.with_compiled_invokers(lambda: (
+            Collections.JoinList(array.array('i', [6, 7])),
+            Collections.JoinEnumerable(array.array('h', [8, 9])),
+            Collections.SumDoubles(array.array('f', [0.5, 1.5, 2.0]))))
+        self.assertEqual(results, [("List`1:6,7", "List`1:8,9", 4.0)] * 2)
+
+    @unittest.skipIf(sys.version_info[0] < 3, "buffer protocol requires Python 3")
+    def test_buffer_rank(self):
+
+        from PyDotnetTest import Arrays
+        flat = memoryview(array.array('i', range(6)))
+        grid = flat.cast('B').cast('i', [2, 3])
+        self.assertEqual(list(Arrays.Int32(flat)), list(range(6)))
+        self.assertEqual(Arrays.Shape(grid), "2x3:3")
+        # Two dimensional buffer is not flattened into one dimensional array
+        self.assertRaises(Exception, Arrays.Int32, grid)
+        self.assertRaises(Exception, Arrays.Shape, flat)
+
+    def test_sequence_views(self):
+
+        from PyDotnetTest import Views
+        items = view([10, 20, 30])
+        self.assertTrue(Views.Describe(items).startswith("PythonSequenceView"))
+        self.assertEqual(Views.Describe(items).split(":")[1], "3")
+        self.assertEqual(Views.ItemAt(items, 1), 20)
+        self.assertEqual(Views.ItemAt(view((4, 5)), 0), 4)
+        self.assertEqual(Views.Sum(view(x for x in range(4))), 6)
+        # Mapping is not sequence, so it is copied, and copy of dict is not a list
+        self.assertRaises(Exception, Views.ItemAt, view({'a': 1}), 0)
+
+    def test_sequence_view_bounds(self):
+
+        from PyDotnetTest import Views
+
+        class Shrinking(object):
+            def __len__(self):
+                return 3
+
+            def __getitem__(self, index):
+                raise IndexError(index)
+
+        items = view([10, 20, 30])
+        self.assertEqual(Views.ErrorAt(items, 2), "30")
+        # Index is not counted from the end, and is checked against length
+        self.assertEqual(Views.ErrorAt(items, -1), "ArgumentOutOfRangeException")
+        self.assertEqual(Views.ErrorAt(items, 3), "ArgumentOutOfRangeException")
+        self.assertEqual(Views.ErrorAt(view(Shrinking()), 0), "ArgumentOutOfRangeException")
+
+    def test_mapping_views(self):
+
+        from PyDotnetTest import Views
+        self.assertEqual(Views.DescribeMapping({'a': 1, 'b': 2}), "Dictionary`2:2")
+        self.assertEqual(Views.Lookup({'a': 1, 'b': 2}, 'b'), 2)
+        self.assertEqual(Views.Lookup({'a': 1}, 'b'), -1)
+        mapping = view({'a': 1, 'b': 2})
+        self.assertTrue(Views.DescribeMapping(mapping).startswith("PythonMappingView"))
+        self.assertEqual(Views.Lookup(mapping, 'a'), 1)
+        self.assertEqual(Views.Lookup(mapping, 'c'), -1)
+        # Sequence is not mapping, so it is copied, and copy of list is not a dictionary
+        self.assertRaises(Exception, Views.Lookup, view([1, 2]), 'a')
+
+    def test_handles_share_members(self):
+
+        from dotnet import PyDotnet
+        from PyDotnetTest import Point
+        first = Point(1, 2)
+        self.assertEqual((first.X, first.Y, first.Sum()), (1, 2, 3))
+        count = PyDotnet.Interop.stats()['member_descriptors']
+        second = Point(3, 4)
+        self.assertEqual((second.X, second.Y, second.Sum()), (3, 4, 7))
+        self.assertEqual(PyDotnet.Interop.stats()['member_descriptors'], count)
+
+    def test_compiled_accessors(self):
+
+        from dotnet import PyDotnet
+        from PyDotnetTest import Point
+        callable_type = PyDotnet.Interop.Callable
+        compiled = callable_type.__compiledinvokers__
+        results = []
+        try:
+            for enabled in (True, False):
+                callable_type.__compiledinvokers__ = enabled
+                p = Point(1, 2)
+                p.X = 10
+                p.Y = 20
+                p.Name = "p"
+                results.append((p.X, p.Y, p.Name, p.Sum()))
+                p.Name = None
+                self.assertIsNone(p.Name)
+                # Exception thrown by getter is wrapped just as reflection wraps it
+                with self.assertRaises(Exception) as raised:
+                    p.Broken
+                error = str(raised.exception)
+                results.append((error.startswith('System.Reflection.TargetInvocationException'), 'broken' in error))
+        finally:
+            callable_type.__compiledinvokers__ = compiled
+        self.assertEqual(results, [(10, 20, "p", 30), (True, True)] * 2)
+
+
+# noinspection PyUnresolvedReferences
+@unittest.skipIf(sys.version_info[0] < 3, "buffer protocol requires Python 3")
+class TestConversionKernels(unittest.TestCase):
+
+    @classmethod
+    def setUpClass(cls):
+        from dotnet import PyDotnet
+        build_fixture()
+        cls.Interop = PyDotnet.Interop
+        cls.default_instruction_set = cls.Interop.__instructionset__
+        cls.instruction_sets = []
+        for name in KERNEL_INSTRUCTION_SETS:
+            cls.Interop.__instructionset__ = name
+            if cls.Interop.__instructionset__ == name:
+                cls.instruction_sets.append(name)
+        cls.Interop.__instructionset__ = cls.default_instruction_set
+
+    def tearDown(self):
+        self.Interop.__instructionset__ = self.default_instruction_set
+
+    @staticmethod
+    def edge_values(kind):
+        """Values stored by array of given kind, at and around limits of every item kind."""
+        code, _, lo, hi = kind
+        ints = set([0, 1, -1])
+        for _, _, klo, khi in KERNEL_KINDS:
+            if klo is not None:
+                ints.update([klo - 1, klo, klo + 1, khi - 1, khi, khi + 1])
+        if lo is not None:
+            return sorted(x for x in ints if lo <= x <= hi)
+        floats = [float(x) for x in ints] + [
+            0.5, -0.5, 0.99, -0.99, 1.5, -1.5, 2.5, -2.5, 127.9, -128.9, 255.5,
+            2.0 ** 31 - 0.5, -2.0 ** 31 - 0.5, 2.0 ** 64, -2.0 ** 64, 3.4e38, 1e300, -1e300,
+            float('inf'), float('-inf'), float('nan')]
+        # Array rounds values to its own precision, e.g. 1e300 becomes inf in float32 array
+        return [array.array(code, [x])[0] for x in floats]
+
+    @staticmethod
+    def expected(value, kind):
+        """Item produced by checked conversion of value, or KERNEL_OVERFLOW."""
+        code, _, lo, hi = kind
+        if lo is not None:
+            if isinstance(value, float):
+                if math.isnan(value) or math.isinf(value):
+                    return KERNEL_OVERFLOW
+                value = int(math.trunc(value))
+            return value if lo <= value <= hi else KERNEL_OVERFLOW
+        value = float(value)
+        float_max = struct.unpack('<f', b'\xff\xff\x7f\x7f')[0]
+        if code == 'f' and not math.isinf(value) and not math.isnan(value) and abs(value) > float_max:
+            return KERNEL_OVERFLOW
+        return array.array(code, [value])[0]
+
+    def convert(self, values, src, dst):
+        from PyDotnetTest import Arrays
+        try:
+            return list(getattr(Arrays, dst[1])(array.array(src[0], values)))
+        except OverflowError:
+            return KERNEL_OVERFLOW
+
+    def assertSameItems(self, actual, expected, msg):
+        # NaN compares unequal to itself, so items are compared by their representation
+        self.assertEqual(repr(actual), repr(expected), msg)
+
+    def test_kernels_match_model(self):
+
+        for name in self.instruction_sets:
+            self.Interop.__instructionset__ = name
+            for src in KERNEL_KINDS:
+                values = self.edge_values(src)
+                for dst in KERNEL_KINDS:
+                    fitting = []
+                    for value in values:
+                        msg = '%s: %s %r -> %s' % (name, src[1], value, dst[1])
+                        expected = self.expected(value, dst)
+                        actual = self.convert([value] * KERNEL_RUN_LENGTH, src, dst)
+                        if expected == KERNEL_OVERFLOW:
+                            self.assertEqual(actual, KERNEL_OVERFLOW, msg)
+                            # Item out of range is found at any position
+                            run = [0] * KERNEL_RUN_LENGTH
+                            run[-1] = value
+                            self.assertEqual(self.convert(run, src, dst), KERNEL_OVERFLOW, msg)
+                        else:
+                            self.assertSameItems(actual, [expected] * KERNEL_RUN_LENGTH, msg)
+                            fitting.append(value)
+                    # Different values in neighbouring lanes
+                    msg = '%s: %s -> %s' % (name, src[1], dst[1])
+                    mixed = (fitting * KERNEL_RUN_LENGTH)[:max(len(fitting), KERNEL_RUN_LENGTH)]
+                    self.assertSameItems(self.convert(mixed, src, dst), [self.expected(x, dst) for x in mixed], msg)
+
+    def test_kernels_agree_across_instruction_sets(self):
+
+        results = {}
+        for name in self.instruction_sets:
+            self.Interop.__instructionset__ = name
+            for src in KERNEL_KINDS:
+                values = self.edge_values(src)
+                for dst in KERNEL_KINDS:
+                    results.setdefault((src[1], dst[1]), []).append(
+                        repr([self.convert([x] * KERNEL_RUN_LENGTH, src, dst) for x in values]))
+        for pair, outputs in results.items():
+            self.assertEqual(len(set(outputs)), 1, '%s -> %s differs between %s' % (pair + (self.instruction_sets,)))
+
+
+# noinspection PyUnresolvedReferences
+class TestPythonTypes(unittest.TestCase):
+
+    def setUp(self):
+        from dotnet import PyDotnet
+        self.Object = PyDotnet.Interop.Object
+        self.Object.__pythontypes__ = True
+
+    def tearDown(self):
+        self.Object.__pythontypes__ = False
+
+    def test_members_are_descriptors(self):
+
+        from System import Version
+        v = Version(1, 2, 3)
+        self.assertIsInstance(v, self.Object)
+        self.assertIn('Major', type(v).__dict__)
+        self.assertEqual(v.Major, 1)
+        self.assertEqual(v.ToString(), "1.2.3")
+        self.assertIs(type(v), type(Version(4, 5)))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,783 @@
+// The MIT License (MIT) Copyright (c) 2016, Susquehanna International Group
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INCLUDED_PYDOTNET_COMPILED_INVOKERS_H
+#define INCLUDED_PYDOTNET_COMPILED_INVOKERS_H
+#pragma managed(push)
+#pragma managed
+
+#include "ManagedReferences.h"
+
+namespace InteropPython
+{
+	public delegate System::Object ^ CompiledMethodInvoker(System::Object ^target, array<System::Object ^> ^args);
+
+	public delegate System::Object ^ CompiledConstructorInvoker(array<System::Object ^> ^args);
+
+	public delegate void CompiledSetter(System::Object ^target, System::Object ^value);
+
+	public delegate System::Object ^ CompiledCollectionBuilder(System::Array ^items);
+
+	public delegate System::Object ^ CompiledDictionaryBuilder(System::Array ^keys, System::Array ^values);
+
+	// Receives arguments of delegate invocation boxed, and stores new values of REF and OUT 
+	// parameters back into the same array. Returns value to be returned from delegate.
+	public interface class ICallbackTarget
+	{
+		System::Object ^ Invoke(array<System::Object ^> ^args);
+	};
+
+	public delegate System::Delegate ^ CompiledCallbackFactory(ICallbackTarget ^target);
+
+	// Builds strongly-typed invokers for methods, constructors, properties and fields using expression trees.
+	// Invokers are compiled on first use and cached for the lifetime of the process.
+	// Methods that cannot be compiled (ref / out parameters, open generics, pointers)
+	// are cached as nullptr, and callers are expected to fall back to reflection.
+	public ref class CompiledInvokers abstract sealed
+	{
+	public:
+		static CompiledMethodInvoker ^ GetMethodInvoker(System::Reflection::MethodInfo ^mi)
+		{
+			System::Delegate ^invoker;
+			if (!_invokers->TryGetValue(mi, invoker))
+			{
+				invoker = CompileMethodInvoker(mi);
+				_invokers->TryAdd(mi, invoker);
+			}
+			return static_cast<CompiledMethodInvoker ^>(invoker);
+		}
+
+		static CompiledConstructorInvoker ^ GetConstructorInvoker(System::Reflection::ConstructorInfo ^ci)
+		{
+			System::Delegate ^invoker;
+			if (!_invokers->TryGetValue(ci, invoker))
+			{
+				invoker = CompileConstructorInvoker(ci);
+				_invokers->TryAdd(ci, invoker);
+			}
+			return static_cast<CompiledConstructorInvoker ^>(invoker);
+		}
+
+		// Getter is of type Func<Object, T>, where T is return type of given delegate type, 
+		// so that primitive values can be read without boxing them.
+		static System::Delegate ^ GetGetter(System::Reflection::MemberInfo ^member, System::Type ^delegateType)
+		{
+			System::Delegate ^getter;
+			if (!_getters->TryGetValue(member, getter))
+			{
+				getter = CompileGetter(member, delegateType);
+				_getters->TryAdd(member, getter);
+			}
+			return getter;
+		}
+
+		static CompiledSetter ^ GetSetter(System::Reflection::MemberInfo ^member)
+		{
+			System::Delegate ^setter;
+			if (!_setters->TryGetValue(member, setter))
+			{
+				setter = CompileSetter(member);
+				_setters->TryAdd(member, setter);
+			}
+			return static_cast<CompiledSetter ^>(setter);
+		}
+
+		// Builder creates collection (i.e. List<T>, HashSet<T>) pre-sized for items given as T[], 
+		// and fills it with single AddRange call, or with typed Add calls.
+		static CompiledCollectionBuilder ^ GetCollectionBuilder(System::Type ^collectionType)
+		{
+			System::Delegate ^builder;
+			if (!_builders->TryGetValue(collectionType, builder))
+			{
+				builder = CompileCollectionBuilder(collectionType);
+				_builders->TryAdd(collectionType, builder);
+			}
+			return static_cast<CompiledCollectionBuilder ^>(builder);
+		}
+
+		// Builder creates dictionary (i.e. Dictionary<K, V>) pre-sized for keys and values given as K[] and V[], 
+		// and fills it with typed Add calls.
+		static CompiledDictionaryBuilder ^ GetDictionaryBuilder(System::Type ^dictionaryType)
+		{
+			System::Delegate ^builder;
+			if (!_builders->TryGetValue(dictionaryType, builder))
+			{
+				builder = CompileDictionaryBuilder(dictionaryType);
+				_builders->TryAdd(dictionaryType, builder);
+			}
+			return static_cast<CompiledDictionaryBuilder ^>(builder);
+		}
+
+		// Factory creates delegate of exactly given type, which forwards its invocations to callback target.
+		// Works for any signature, including REF and OUT parameters, and any number of parameters.
+		static CompiledCallbackFactory ^ GetCallbackFactory(System::Type ^delegateType)
+		{
+			System::Delegate ^factory;
+			if (!_callbacks->TryGetValue(delegateType, factory))
+			{
+				factory = CompileCallbackFactory(delegateType);
+				_callbacks->TryAdd(delegateType, factory);
+			}
+			return static_cast<CompiledCallbackFactory ^>(factory);
+		}
+
+		static int GetCount()
+		{
+			return _invokers->Count + _getters->Count + _setters->Count + _builders->Count + _callbacks->Count;
+		}
+
+		// Reflection quietly converts arguments, which do not match exactly parameter type,
+		// i.e. null becomes default value, Int32 is widened to Int64, or integer becomes enum.
+		// Any other conversion throws, and then call is left to reflection, which decides whether it succeeds.
+		static System::Object ^ CoerceArgument(System::Object ^value, System::Type ^type)
+		{
+			if (value == nullptr)
+			{
+				return System::Activator::CreateInstance(type);
+			}
+
+			System::Type ^source = value->GetType();
+			System::Type ^target = type->IsEnum ? System::Enum::GetUnderlyingType(type) : type;
+			if (source->IsEnum)
+			{
+				source = System::Enum::GetUnderlyingType(source);
+			}
+			if (!CanWiden(System::Type::GetTypeCode(source), System::Type::GetTypeCode(target)))
+			{
+				throw gcnew System::InvalidCastException(System::String::Format("{0} is not widened to {1}", value->GetType(), type));
+			}
+
+			if (type->IsEnum)
+			{
+				return System::Enum::ToObject(type, value);
+			}
+			return System::Convert::ChangeType(value, type);
+		}
+
+	private:
+		static CompiledInvokers()
+		{
+			_invokers = gcnew System::Collections::Concurrent::ConcurrentDictionary<
+				System::Reflection::MethodBase ^, System::Delegate ^>();
+			_getters = gcnew System::Collections::Concurrent::ConcurrentDictionary<
+				System::Reflection::MemberInfo ^, System::Delegate ^>();
+			_setters = gcnew System::Collections::Concurrent::ConcurrentDictionary<
+				System::Reflection::MemberInfo ^, System::Delegate ^>();
+			_builders = gcnew System::Collections::Concurrent::ConcurrentDictionary<
+				System::Type ^, System::Delegate ^>();
+			_callbacks = gcnew System::Collections::Concurrent::ConcurrentDictionary<
+				System::Type ^, System::Delegate ^>();
+		}
+
+		static int Bit(System::TypeCode code)
+		{
+			return 1 << (int)code;
+		}
+
+		// Widening conversions of primitive types, which reflection performs on arguments
+		static bool CanWiden(System::TypeCode from, System::TypeCode to)
+		{
+			using System::TypeCode;
+
+			const int toReal = Bit(TypeCode::Single) | Bit(TypeCode::Double);
+			int allowed;
+			switch (from)
+			{
+			case TypeCode::Char:
+				allowed = Bit(TypeCode::Char) | Bit(TypeCode::UInt16) | Bit(TypeCode::UInt32) | Bit(TypeCode::Int32) | 
+					Bit(TypeCode::UInt64) | Bit(TypeCode::Int64) | toReal;
+				break;
+			case TypeCode::SByte:
+				allowed = Bit(TypeCode::SByte) | Bit(TypeCode::Int16) | Bit(TypeCode::Int32) | Bit(TypeCode::Int64) | toReal;
+				break;
+			case TypeCode::Byte:
+				allowed = Bit(TypeCode::Byte) | Bit(TypeCode::Char) | Bit(TypeCode::UInt16) | Bit(TypeCode::Int16) | 
+					Bit(TypeCode::UInt32) | Bit(TypeCode::Int32) | Bit(TypeCode::UInt64) | Bit(TypeCode::Int64) | toReal;
+				break;
+			case TypeCode::Int16:
+				allowed = Bit(TypeCode::Int16) | Bit(TypeCode::Int32) | Bit(TypeCode::Int64) | toReal;
+				break;
+			case TypeCode::UInt16:
+				allowed = Bit(TypeCode::UInt16) | Bit(TypeCode::UInt32) | Bit(TypeCode::Int32) | 
+					Bit(TypeCode::UInt64) | Bit(TypeCode::Int64) | toReal;
+				break;
+			case TypeCode::Int32:
+				allowed = Bit(TypeCode::Int32) | Bit(TypeCode::Int64) | toReal;
+				break;
+			case TypeCode::UInt32:
+				allowed = Bit(TypeCode::UInt32) | Bit(TypeCode::UInt64) | Bit(TypeCode::Int64) | toReal;
+				break;
+			case TypeCode::Int64:
+				allowed = Bit(TypeCode::Int64) | toReal;
+				break;
+			case TypeCode::UInt64:
+				allowed = Bit(TypeCode::UInt64) | toReal;
+				break;
+			case TypeCode::Single:
+				allowed = toReal;
+				break;
+			default:
+				// Boolean, Double and non-primitive types are only passed as they are
+				return from == to && from != TypeCode::Object;
+			}
+			return (allowed & Bit(to)) != 0;
+		}
+
+		// Exceptions thrown by member are wrapped just as reflection wraps them, so that any other exception 
+		// thrown by compiled invoker comes from converting arguments, before member was called.
+		static System::Linq::Expressions::Expression ^ WrapInvocation(System::Linq::Expressions::Expression ^call)
+		{
+			using namespace System::Linq::Expressions;
+
+			ParameterExpression ^err = Expression::Parameter(System::Exception::typeid, "err");
+			System::Reflection::ConstructorInfo ^wrap = System::Reflection::TargetInvocationException::typeid->GetConstructor(
+				gcnew array<System::Type ^> { System::Exception::typeid });
+
+			return Expression::TryCatch(call,
+				Expression::Catch(err, Expression::Throw(Expression::New(wrap, err), call->Type)));
+		}
+
+		static bool CanCompile(System::Reflection::MethodBase ^mb)
+		{
+			if (mb->ContainsGenericParameters)
+			{
+				return false;
+			}
+
+			array<System::Reflection::ParameterInfo ^> ^pis = mb->GetParameters();
+			for (int i = 0; i != pis->Length; ++i)
+			{
+				// OUT and REF parameters are written back into arguments array by reflection
+				System::Type ^pt = pis[i]->ParameterType;
+				if (pt->IsByRef || pt->IsPointer)
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		// Arguments are converted into variables by steps run before member is called, 
+		// so that conversion failures are not wrapped as exceptions thrown by member.
+		static array<System::Linq::Expressions::Expression ^> ^ ConvertArguments(
+			array<System::Reflection::ParameterInfo ^> ^pis,
+			System::Linq::Expressions::ParameterExpression ^args,
+			List<System::Linq::Expressions::ParameterExpression ^> ^variables,
+			List<System::Linq::Expressions::Expression ^> ^steps)
+		{
+			using namespace System::Linq::Expressions;
+
+			array<Expression ^> ^callArgs = gcnew array<Expression ^>(pis->Length);
+			for (int i = 0; i != pis->Length; ++i)
+			{
+				ParameterExpression ^variable = Expression::Variable(pis[i]->ParameterType, "arg" + i.ToString());
+				steps->Add(Expression::Assign(variable,
+					ConvertArgument(Expression::ArrayIndex(args, Expression::Constant(i)), pis[i]->ParameterType)));
+				variables->Add(variable);
+				callArgs[i] = variable;
+			}
+			return callArgs;
+		}
+
+		static System::Linq::Expressions::Expression ^ ConvertArgument(
+			System::Linq::Expressions::Expression ^arg, System::Type ^pt)
+		{
+			using namespace System::Linq::Expressions;
+
+			if (pt->IsValueType && System::Nullable::GetUnderlyingType(pt) == nullptr)
+			{
+				Expression ^coerced = Expression::Call(
+					CompiledInvokers::typeid->GetMethod("CoerceArgument"), arg, Expression::Constant(pt, System::Type::typeid));
+
+				return Expression::Condition(
+					Expression::TypeIs(arg, pt),
+					Expression::Unbox(arg, pt),
+					Expression::Convert(coerced, pt));
+			}
+			return Expression::Convert(arg, pt);
+		}
+
+		// Returns instance on which member is accessed, or nullptr if member is static
+		static System::Linq::Expressions::Expression ^ ConvertTarget(
+			System::Linq::Expressions::ParameterExpression ^target, System::Reflection::MemberInfo ^member, bool isStatic)
+		{
+			using namespace System::Linq::Expressions;
+
+			if (isStatic)
+			{
+				return nullptr;
+			}
+			if (member->DeclaringType->IsValueType)
+			{
+				return Expression::Unbox(target, member->DeclaringType);
+			}
+			return Expression::Convert(target, member->DeclaringType);
+		}
+
+		// Returns step rejecting null instance with the same exception reflection throws, or nullptr if member is static.
+		// Step runs before member is accessed, so that the exception is not wrapped as thrown by member.
+		static System::Linq::Expressions::Expression ^ CheckTarget(
+			System::Linq::Expressions::ParameterExpression ^target, System::Reflection::MemberInfo ^member, bool isStatic)
+		{
+			using namespace System::Linq::Expressions;
+
+			if (isStatic)
+			{
+				return nullptr;
+			}
+
+			System::String ^message = (member->MemberType == System::Reflection::MemberTypes::Field)
+				? "Non-static field requires a target."
+				: "Non-static method requires a target.";
+			System::Reflection::ConstructorInfo ^ctor = System::Reflection::TargetException::typeid->GetConstructor(
+				gcnew array<System::Type ^> { System::String::typeid });
+
+			return Expression::IfThen(
+				Expression::Equal(target, Expression::Constant(nullptr, System::Object::typeid)),
+				Expression::Throw(Expression::New(ctor, Expression::Constant(message))));
+		}
+
+		static System::Delegate ^ CompileGetter(System::Reflection::MemberInfo ^member, System::Type ^delegateType)
+		{
+			using namespace System::Linq::Expressions;
+
+			bool isStatic;
+			System::Reflection::PropertyInfo ^pi = dynamic_cast<System::Reflection::PropertyInfo ^>(member);
+			System::Reflection::FieldInfo ^fi = dynamic_cast<System::Reflection::FieldInfo ^>(member);
+
+			if (pi != nullptr)
+			{
+				System::Reflection::MethodInfo ^get = pi->GetGetMethod();
+				if (get == nullptr || pi->GetIndexParameters()->Length != 0 || pi->PropertyType->IsByRef || pi->PropertyType->IsPointer)
+				{
+					return nullptr;
+				}
+				isStatic = get->IsStatic;
+			}
+			else if (fi != nullptr)
+			{
+				if (fi->FieldType->IsPointer)
+				{
+					return nullptr;
+				}
+				isStatic = fi->IsStatic;
+			}
+			else
+			{
+				return nullptr;
+			}
+
+			try
+			{
+				ParameterExpression ^target = Expression::Parameter(System::Object::typeid, "target");
+				Expression ^access = Expression::MakeMemberAccess(ConvertTarget(target, member, isStatic), member);
+				if (pi != nullptr)
+				{
+					access = WrapInvocation(access);
+				}
+
+				System::Type ^rt = delegateType->GetMethod("Invoke")->ReturnType;
+				Expression ^body = access->Type->Equals(rt) ? access : safe_cast<Expression ^>(Expression::Convert(access, rt));
+
+				Expression ^check = CheckTarget(target, member, isStatic);
+				if (check != nullptr)
+				{
+					body = Expression::Block(check, body);
+				}
+
+				return Expression::Lambda(delegateType, body, gcnew array<ParameterExpression ^> { target })->Compile();
+			}
+			catch (System::Exception ^)
+			{
+				return nullptr;
+			}
+		}
+
+		static System::Delegate ^ CompileSetter(System::Reflection::MemberInfo ^member)
+		{
+			using namespace System::Linq::Expressions;
+
+			bool isStatic;
+			System::Type ^memberType;
+			System::Reflection::PropertyInfo ^pi = dynamic_cast<System::Reflection::PropertyInfo ^>(member);
+			System::Reflection::FieldInfo ^fi = dynamic_cast<System::Reflection::FieldInfo ^>(member);
+
+			if (pi != nullptr)
+			{
+				System::Reflection::MethodInfo ^set = pi->GetSetMethod();
+				if (set == nullptr || pi->GetIndexParameters()->Length != 0 || pi->PropertyType->IsPointer)
+				{
+					return nullptr;
+				}
+				isStatic = set->IsStatic;
+				memberType = pi->PropertyType;
+			}
+			else if (fi != nullptr)
+			{
+				if (fi->IsInitOnly || fi->IsLiteral || fi->FieldType->IsPointer)
+				{
+					return nullptr;
+				}
+				isStatic = fi->IsStatic;
+				memberType = fi->FieldType;
+			}
+			else
+			{
+				return nullptr;
+			}
+
+			try
+			{
+				ParameterExpression ^target = Expression::Parameter(System::Object::typeid, "target");
+				ParameterExpression ^value = Expression::Parameter(System::Object::typeid, "value");
+
+				// Value is converted before property setter is called
+				ParameterExpression ^converted = Expression::Variable(memberType, "converted");
+				Expression ^assign = Expression::Assign(
+					Expression::MakeMemberAccess(ConvertTarget(target, member, isStatic), member), converted);
+
+				List<Expression ^> ^steps = gcnew List<Expression ^>();
+				Expression ^check = CheckTarget(target, member, isStatic);
+				if (check != nullptr)
+				{
+					steps->Add(check);
+				}
+				steps->Add(Expression::Assign(converted, ConvertArgument(value, memberType)));
+				steps->Add(pi != nullptr ? WrapInvocation(assign) : assign);
+
+				Expression ^body = Expression::Block(gcnew array<ParameterExpression ^> { converted }, steps);
+
+				return Expression::Lambda<CompiledSetter ^>(body,
+					gcnew array<ParameterExpression ^> { target, value })->Compile();
+			}
+			catch (System::Exception ^)
+			{
+				return nullptr;
+			}
+		}
+
+		static System::Delegate ^ CompileMethodInvoker(System::Reflection::MethodInfo ^mi)
+		{
+			using namespace System::Linq::Expressions;
+
+			if (!CanCompile(mi) || mi->ReturnType->IsByRef || mi->ReturnType->IsPointer)
+			{
+				return nullptr;
+			}
+
+			try
+			{
+				ParameterExpression ^target = Expression::Parameter(System::Object::typeid, "target");
+				ParameterExpression ^args = Expression::Parameter(array<System::Object ^>::typeid, "args");
+				List<ParameterExpression ^> ^variables = gcnew List<ParameterExpression ^>();
+				List<Expression ^> ^steps = gcnew List<Expression ^>();
+				Expression ^check = CheckTarget(target, mi, mi->IsStatic);
+				if (check != nullptr)
+				{
+					steps->Add(check);
+				}
+				array<Expression ^> ^callArgs = ConvertArguments(mi->GetParameters(), args, variables, steps);
+
+				Expression ^call;
+				if (mi->IsStatic)
+				{
+					call = Expression::Call(mi, callArgs);
+				}
+				else if (mi->DeclaringType->IsValueType)
+				{
+					// Call on unboxed reference, so that method may modify boxed value just like with reflection
+					call = Expression::Call(Expression::Unbox(target, mi->DeclaringType), mi, callArgs);
+				}
+				else
+				{
+					call = Expression::Call(Expression::Convert(target, mi->DeclaringType), mi, callArgs);
+				}
+				call = WrapInvocation(call);
+
+				steps->Add(mi->ReturnType->Equals(System::Void::typeid)
+					? safe_cast<Expression ^>(Expression::Block(call, Expression::Constant(nullptr, System::Object::typeid)))
+					: safe_cast<Expression ^>(Expression::Convert(call, System::Object::typeid)));
+
+				Expression ^body = Expression::Block(variables, steps);
+
+				return Expression::Lambda<CompiledMethodInvoker ^>(body,
+					gcnew array<ParameterExpression ^> { target, args })->Compile();
+			}
+			catch (System::Exception ^)
+			{
+				return nullptr;
+			}
+		}
+
+		static System::Delegate ^ CompileConstructorInvoker(System::Reflection::ConstructorInfo ^ci)
+		{
+			using namespace System::Linq::Expressions;
+
+			if (!CanCompile(ci) || ci->IsStatic || ci->DeclaringType->IsAbstract)
+			{
+				return nullptr;
+			}
+
+			try
+			{
+				ParameterExpression ^args = Expression::Parameter(array<System::Object ^>::typeid, "args");
+				List<ParameterExpression ^> ^variables = gcnew List<ParameterExpression ^>();
+				List<Expression ^> ^steps = gcnew List<Expression ^>();
+				array<Expression ^> ^callArgs = ConvertArguments(ci->GetParameters(), args, variables, steps);
+
+				steps->Add(Expression::Convert(WrapInvocation(Expression::New(ci, callArgs)), System::Object::typeid));
+				Expression ^body = Expression::Block(variables, steps);
+
+				return Expression::Lambda<CompiledConstructorInvoker ^>(body,
+					gcnew array<ParameterExpression ^> { args })->Compile();
+			}
+			catch (System::Exception ^)
+			{
+				return nullptr;
+			}
+		}
+
+		static System::Collections::Concurrent::ConcurrentDictionary<
+			System::Reflection::MethodBase ^, System::Delegate ^> ^_invokers;
+
+		static System::Collections::Concurrent::ConcurrentDictionary<
+			System::Reflection::MemberInfo ^, System::Delegate ^> ^_getters;
+
+		// Constructs instance with initial capacity if type has such constructor, otherwise with default constructor
+		static System::Linq::Expressions::Expression ^ NewWithCapacity(
+			System::Type ^type, System::Linq::Expressions::Expression ^capacity)
+		{
+			using namespace System::Linq::Expressions;
+
+			System::Reflection::ConstructorInfo ^ci = type->GetConstructor(gcnew array<System::Type ^> { System::Int32::typeid });
+			if (ci != nullptr && ci->GetParameters()[0]->Name == "capacity")
+			{
+				return Expression::New(ci, capacity);
+			}
+
+			ci = type->GetConstructor(System::Type::EmptyTypes);
+			if (ci == nullptr)
+			{
+				return nullptr;
+			}
+			return Expression::New(ci);
+		}
+
+		// Loop over items of array calling body with item index
+		static System::Linq::Expressions::Expression ^ ForEachIndex(
+			System::Linq::Expressions::Expression ^items, 
+			System::Linq::Expressions::ParameterExpression ^index, 
+			System::Linq::Expressions::Expression ^body)
+		{
+			using namespace System::Linq::Expressions;
+
+			LabelTarget ^done = Expression::Label("done");
+			return Expression::Block(
+				Expression::Assign(index, Expression::Constant(0)),
+				Expression::Loop(
+					Expression::IfThenElse(
+						Expression::LessThan(index, Expression::ArrayLength(items)),
+						Expression::Block(body, Expression::PreIncrementAssign(index)),
+						Expression::Break(done)),
+					done));
+		}
+
+		static System::Delegate ^ CompileCollectionBuilder(System::Type ^collectionType)
+		{
+			using namespace System::Linq::Expressions;
+
+			if (!collectionType->IsGenericType || collectionType->IsInterface || collectionType->IsAbstract || 
+				collectionType->ContainsGenericParameters || collectionType->GetGenericArguments()->Length != 1)
+			{
+				return nullptr;
+			}
+
+			try
+			{
+				System::Type ^itemType = collectionType->GetGenericArguments()[0];
+				System::Type ^enumerableType = System::Collections::Generic::IEnumerable<System::Object ^>::typeid->
+					GetGenericTypeDefinition()->MakeGenericType(itemType);
+
+				System::Reflection::MethodInfo ^addRange = collectionType->GetMethod("AddRange", gcnew array<System::Type ^> { enumerableType });
+				System::Reflection::MethodInfo ^add = collectionType->GetMethod("Add", gcnew array<System::Type ^> { itemType });
+				if (addRange == nullptr && add == nullptr)
+				{
+					return nullptr;
+				}
+
+				ParameterExpression ^items = Expression::Parameter(System::Array::typeid, "items");
+				ParameterExpression ^typedItems = Expression::Variable(itemType->MakeArrayType(), "typedItems");
+				ParameterExpression ^result = Expression::Variable(collectionType, "result");
+				ParameterExpression ^index = Expression::Variable(System::Int32::typeid, "index");
+
+				Expression ^create = NewWithCapacity(collectionType, Expression::ArrayLength(typedItems));
+				if (create == nullptr)
+				{
+					return nullptr;
+				}
+
+				Expression ^fill = addRange != nullptr
+					? safe_cast<Expression ^>(Expression::Call(result, addRange, typedItems))
+					: ForEachIndex(typedItems, index, Expression::Call(result, add, Expression::ArrayIndex(typedItems, index)));
+
+				Expression ^body = Expression::Block(
+					gcnew array<ParameterExpression ^> { typedItems, result, index },
+					Expression::Assign(typedItems, Expression::Convert(items, typedItems->Type)),
+					Expression::Assign(result, create),
+					fill,
+					Expression::Convert(result, System::Object::typeid));
+
+				return Expression::Lambda<CompiledCollectionBuilder ^>(body,
+					gcnew array<ParameterExpression ^> { items })->Compile();
+			}
+			catch (System::Exception ^)
+			{
+				return nullptr;
+			}
+		}
+
+		static System::Delegate ^ CompileDictionaryBuilder(System::Type ^dictionaryType)
+		{
+			using namespace System::Linq::Expressions;
+
+			if (!dictionaryType->IsGenericType || dictionaryType->IsInterface || dictionaryType->IsAbstract || 
+				dictionaryType->ContainsGenericParameters || dictionaryType->GetGenericArguments()->Length != 2)
+			{
+				return nullptr;
+			}
+
+			try
+			{
+				array<System::Type ^> ^genericArgs = dictionaryType->GetGenericArguments();
+				System::Reflection::MethodInfo ^add = dictionaryType->GetMethod("Add", genericArgs);
+				if (add == nullptr)
+				{
+					return nullptr;
+				}
+
+				ParameterExpression ^keys = Expression::Parameter(System::Array::typeid, "keys");
+				ParameterExpression ^values = Expression::Parameter(System::Array::typeid, "values");
+				ParameterExpression ^typedKeys = Expression::Variable(genericArgs[0]->MakeArrayType(), "typedKeys");
+				ParameterExpression ^typedValues = Expression::Variable(genericArgs[1]->MakeArrayType(), "typedValues");
+				ParameterExpression ^result = Expression::Variable(dictionaryType, "result");
+				ParameterExpression ^index = Expression::Variable(System::Int32::typeid, "index");
+
+				Expression ^create = NewWithCapacity(dictionaryType, Expression::ArrayLength(typedKeys));
+				if (create == nullptr)
+				{
+					return nullptr;
+				}
+
+				Expression ^body = Expression::Block(
+					gcnew array<ParameterExpression ^> { typedKeys, typedValues, result, index },
+					Expression::Assign(typedKeys, Expression::Convert(keys, typedKeys->Type)),
+					Expression::Assign(typedValues, Expression::Convert(values, typedValues->Type)),
+					Expression::Assign(result, create),
+					ForEachIndex(typedKeys, index, Expression::Call(result, add, 
+						Expression::ArrayIndex(typedKeys, index), Expression::ArrayIndex(typedValues, index))),
+					Expression::Convert(result, System::Object::typeid));
+
+				return Expression::Lambda<CompiledDictionaryBuilder ^>(body,
+					gcnew array<ParameterExpression ^> { keys, values })->Compile();
+			}
+			catch (System::Exception ^)
+			{
+				return nullptr;
+			}
+		}
+
+		static System::Collections::Concurrent::ConcurrentDictionary<
+			System::Reflection::MemberInfo ^, System::Delegate ^> ^_setters;
+
+		// Compiles target => (delegateType)((a1, ..., aN) => (R)target.Invoke(new object[] { a1, ..., aN })),
+		// where REF and OUT parameters are assigned from arguments array after invocation.
+		static System::Delegate ^ CompileCallbackFactory(System::Type ^delegateType)
+		{
+			using namespace System::Linq::Expressions;
+
+			System::Reflection::MethodInfo ^signature = delegateType->GetMethod("Invoke");
+			if (signature == nullptr || delegateType->ContainsGenericParameters)
+			{
+				return nullptr;
+			}
+
+			try
+			{
+				array<System::Reflection::ParameterInfo ^> ^pis = signature->GetParameters();
+				array<ParameterExpression ^> ^params = gcnew array<ParameterExpression ^>(pis->Length);
+				array<Expression ^> ^boxedParams = gcnew array<Expression ^>(pis->Length);
+				for (int i = 0; i != pis->Length; ++i)
+				{
+					if (pis[i]->ParameterType->IsPointer)
+					{
+						return nullptr;
+					}
+					params[i] = Expression::Parameter(pis[i]->ParameterType, pis[i]->Name);
+					boxedParams[i] = Expression::Convert(params[i], System::Object::typeid);
+				}
+
+				ParameterExpression ^target = Expression::Parameter(ICallbackTarget::typeid, "target");
+				ParameterExpression ^args = Expression::Variable(array<System::Object ^>::typeid, "args");
+				ParameterExpression ^result = Expression::Variable(System::Object::typeid, "result");
+
+				System::Collections::Generic::List<Expression ^> ^body = gcnew System::Collections::Generic::List<Expression ^>();
+				body->Add(Expression::Assign(args, Expression::NewArrayInit(System::Object::typeid, boxedParams)));
+				body->Add(Expression::Assign(result, Expression::Call(target, ICallbackTarget::typeid->GetMethod("Invoke"), args)));
+
+				for (int i = 0; i != pis->Length; ++i)
+				{
+					if (params[i]->IsByRef)
+					{
+						body->Add(Expression::Assign(params[i], 
+							ConvertArgument(Expression::ArrayIndex(args, Expression::Constant(i)), params[i]->Type)));
+					}
+				}
+
+				if (!signature->ReturnType->Equals(System::Void::typeid))
+				{
+					body->Add(ConvertArgument(result, signature->ReturnType));
+				}
+				else
+				{
+					body->Add(Expression::Empty());
+				}
+
+				LambdaExpression ^thunk = Expression::Lambda(delegateType, 
+					Expression::Block(gcnew array<ParameterExpression ^> { args, result }, body), params);
+
+				return Expression::Lambda<CompiledCallbackFactory ^>(thunk, 
+					gcnew array<ParameterExpression ^> { target })->Compile();
+			}
+			catch (System::Exception ^)
+			{
+				return nullptr;
+			}
+		}
+
+		static System::Collections::Concurrent::ConcurrentDictionary<
+			System::Type ^, System::Delegate ^> ^_builders;
+
+		static System::Collections::Concurrent::ConcurrentDictionary<
+			System::Type ^, System::Delegate ^> ^_callbacks;
+	};
+}
+
+#pragma managed(pop)
+#endif // INCLUDED...
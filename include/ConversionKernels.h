@@ -0,0 +1,88 @@
+// The MIT License (MIT) Copyright (c) 2016, Susquehanna International Group
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef INCLUDED_PYDOTNET_CONVERSION_KERNELS_H
+#define INCLUDED_PYDOTNET_CONVERSION_KERNELS_H
+#pragma managed(push)
+#pragma unmanaged
+
+#include <cstddef>
+
+namespace InteropPython {
+
+	// Conversion of contiguous runs of numeric items between types of different width.
+	// Used when python buffer is copied into managed array of different element type, 
+	// e.g. int64 numpy array into int[], or float32 into double[].
+	// Common pairs use SSE2 or AVX2 loops, which are chosen at runtime, all other pairs use scalar loops.
+	// This is plain C++ code, which does not depend on Python nor on .NET.
+	struct ConversionKernels
+	{
+		enum ItemKind
+		{
+			Int8,
+			UInt8,
+			Int16,
+			UInt16,
+			Int32,
+			UInt32,
+			Int64,
+			UInt64,
+			Single,
+			Double,
+			Unknown
+		};
+
+		enum Result
+		{
+			Converted,
+			Overflow,
+			Unsupported
+		};
+
+		enum InstructionSet
+		{
+			Scalar,
+			SSE2,
+			AVX2
+		};
+
+		// Kind of item described by struct module format (e.g. 'i', '<q', '=f') and item size
+		static ItemKind GetItemKind(const char *format, size_t itemSize);
+
+		static size_t GetItemSize(ItemKind kind);
+
+		// Converts items [begin, end) of src into items [begin, end) of dst.
+		// Narrowing conversions are checked, and Overflow is returned if any item 
+		// does not fit into target type, in which case dst is left partially written.
+		// Ranges may be converted concurrently by different threads.
+		static Result Convert(void *dst, ItemKind dstKind, const void *src, ItemKind srcKind, size_t begin, size_t end);
+
+		// Instruction set used by kernels, by default best one supported by CPU and OS
+		static InstructionSet GetInstructionSet();
+
+		// Limits instruction set used by kernels, e.g. to compare them with scalar loops
+		static void SetInstructionSet(InstructionSet instructionSet);
+	};
+
+} // namespace InteropPython
+
+#pragma managed(pop)
+#endif // INCLUDED...
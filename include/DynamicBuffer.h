@@ -0,0 +1,97 @@
+// The MIT License (MIT) Copyright (c) 2016, Susquehanna International Group
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef INCLUDED_PYDOTNET_DYNAMIC_BUFFER_H
+#define INCLUDED_PYDOTNET_DYNAMIC_BUFFER_H
+
+#include "InteropPythonTypes.h"
+#include "ConversionKernels.h"
+
+namespace InteropPython {
+
+	// Python buffer protocol for managed arrays of primitive element types.
+	// Array stays pinned for as long as any view exported from it is alive,
+	// so that memoryview or numpy can use managed memory without copying.
+	struct DynamicBuffer
+	{
+		// Registers python type of wrappers of managed arrays (i.e. Interop.Array), which is subclass of 
+		// Interop.Object exporting buffers, so that other wrappers do not claim to support buffer protocol.
+		static void Register(const std::string &name);
+
+		// True if wrappers of given managed type are given python type registered by Register
+		static bool Exports(System::Type ^typ);
+
+		// Python type registered by Register
+		static boost::python::object GetArrayClass();
+
+		// Switches class of python wrapper of managed array to python type registered by Register
+		static void Assign(boost::python::object &obj);
+
+		// Struct module format of element type, or nullptr if it cannot be exported
+		static const char *GetFormat(System::Type ^elementType);
+
+		// Size in bytes of element type, which has format
+		static int GetItemSize(System::Type ^elementType);
+
+		// True if python object can be copied in bulk into array of given type
+		static bool CanConvert(const boost::python::object &value, System::Type ^arrayType);
+
+		// Copies python buffer into new managed array in single pass. Items of other numeric type
+		// than element type are converted by ConversionKernels. Returns nullptr if buffer is not
+		// contiguous or its items are not numbers.
+		static System::Array ^ ToManagedArray(const boost::python::object &value, System::Type ^arrayType);
+
+		// Name of instruction set used by ConversionKernels, i.e. 'scalar', 'sse2' or 'avx2'
+		static std::string GetInstructionSet();
+
+		// Limits instruction set used by ConversionKernels, e.g. to compare vector loops with scalar ones.
+		// Set not supported by CPU falls back to best one, which is.
+		static void SetInstructionSet(const std::string &name);
+
+		// Number of arrays pinned for views exported to python
+		static int GetPinnedCount()
+		{
+			return sPinned;
+		}
+
+		// Highest number of arrays pinned at once
+		static int GetPinnedPeakCount()
+		{
+			return sPinnedPeak;
+		}
+
+	private:
+		static int sPinned;
+		static int sPinnedPeak;
+
+		// Never freed, as type must not outlive interpreter
+		static PyObject *sArrayClass;
+
+#if PY_VERSION_HEX >= 0x03000000
+		static int GetBuffer(PyObject *exporter, Py_buffer *view, int flags);
+		static void ReleaseBuffer(PyObject *exporter, Py_buffer *view);
+		static PyBufferProcs sBufferProcs;
+#endif
+	};
+
+}// namespace InteropPython
+
+#endif // INCLUDED...
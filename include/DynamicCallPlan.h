@@ -0,0 +1,93 @@
+// The MIT License (MIT) Copyright (c) 2016, Susquehanna International Group
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef INCLUDED_PYDOTNET_DYNAMIC_CALL_PLAN_H
+#define INCLUDED_PYDOTNET_DYNAMIC_CALL_PLAN_H
+
+#include "InteropPythonTypes.h"
+#include "ManagedReferences.h"
+#include "CompiledInvokers.h"
+
+namespace InteropPython {
+
+	// Everything needed to call a method or constructor, read once from ParameterInfo.
+	// Plans are built on first use, shared by all invokers bound to the same method,
+	// and never freed, so invokers may keep plain pointers to them.
+	struct CallPlan
+	{
+		enum ParameterFlags
+		{
+			Out = 1,		// value is returned after call (out or ref parameter)
+			NoInput = 2,	// no argument is taken from caller (pure out parameter)
+			Optional = 4	// default value is used when argument is missing
+		};
+
+		int nParameters;
+		int nOutArgs;
+		bool isVoid;
+		bool takesCallbacks;	// some parameter is a delegate, which may call back into python
+		mutable bool keepGIL;	// GIL is kept for calls passing python callables (opted in per method)
+		std::vector<int> flags;
+		gcroot<array<System::Type ^> ^> types;
+		gcroot<array<System::Object ^> ^> defaults;
+		gcroot<array<System::Reflection::ParameterInfo ^> ^> parameters;
+
+		static const CallPlan *Get(System::Reflection::MethodBase ^mb);
+
+		// Number of cached plans
+		static int GetCount();
+
+		CompiledMethodInvoker ^GetMethodInvoker() const
+		{
+			if (!_compiled)
+			{
+				_invoker = CompiledInvokers::GetMethodInvoker(safe_cast<System::Reflection::MethodInfo ^>(_mb.operator System::Reflection::MethodBase ^()));
+				_compiled = true;
+			}
+			return static_cast<CompiledMethodInvoker ^>(_invoker.operator System::Delegate ^());
+		}
+
+		CompiledConstructorInvoker ^GetConstructorInvoker() const
+		{
+			if (!_compiled)
+			{
+				_invoker = CompiledInvokers::GetConstructorInvoker(safe_cast<System::Reflection::ConstructorInfo ^>(_mb.operator System::Reflection::MethodBase ^()));
+				_compiled = true;
+			}
+			return static_cast<CompiledConstructorInvoker ^>(_invoker.operator System::Delegate ^());
+		}
+
+	private:
+		explicit CallPlan(System::Reflection::MethodBase ^mb);
+
+		CallPlan(const CallPlan &);
+		CallPlan &operator = (const CallPlan &);
+
+		gcroot<System::Reflection::MethodBase ^> _mb;
+
+		// Compiled invoker is looked up on first call, as it is only used when enabled
+		mutable gcroot<System::Delegate ^> _invoker;
+		mutable bool _compiled;
+	};
+
+}// namespace InteropPython
+
+#endif // INCLUDED...
@@ -0,0 +1,190 @@
+// The MIT License (MIT) Copyright (c) 2016, Susquehanna International Group
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INCLUDED_PYDOTNET_DYNAMIC_EVENTS_H
+#define INCLUDED_PYDOTNET_DYNAMIC_EVENTS_H
+
+#include "DynamicObjectHandle.h"
+
+namespace InteropPython {
+
+	// Bounded lock-free queue of event invocations, into which any number of .NET threads 
+	// enqueue, and from which single python thread (holding the GIL) dequeues.
+	// Producers never wait: when queue is full, invocation is dropped and counted.
+	public ref class EventRing
+	{
+	public:
+		EventRing(int capacity);
+
+		bool TryEnqueue(System::Object ^target, array<System::Object ^> ^args);
+
+		// Must only be called by single consumer at a time
+		bool TryDequeue(System::Object ^%target, array<System::Object ^> ^%args);
+
+		// Waits until some invocations are pending, queue is closed, or timeout expires
+		bool Wait(int millisecondsTimeout);
+
+		void Close();
+
+		property int Capacity { int get() { return _mask + 1; } }
+		property bool IsClosed { bool get() { return _closed; } }
+		property System::Int64 Enqueued { System::Int64 get() { return System::Threading::Interlocked::Read(_enqueuePos); } }
+		property System::Int64 Dispatched { System::Int64 get() { return System::Threading::Interlocked::Read(_dequeuePos); } }
+		property System::Int64 Dropped { System::Int64 get() { return System::Threading::Interlocked::Read(_dropped); } }
+		property System::Int64 Pending { System::Int64 get() { return Enqueued - Dispatched; } }
+
+	private:
+		// Slot is free for enqueue at position p when its sequence is p, 
+		// and holds invocation for dequeue at position p when its sequence is p + 1
+		array<System::Int64> ^_sequences;
+		array<System::Object ^> ^_targets;
+		array<array<System::Object ^> ^> ^_args;
+		int _mask;
+
+		System::Int64 _enqueuePos;
+		System::Int64 _dequeuePos;
+		System::Int64 _dropped;
+
+		System::Threading::ManualResetEventSlim ^_signal;
+		volatile bool _closed;
+	};
+
+	// Target of event handler delegates, which enqueue their invocations instead of calling python
+	ref class QueuedEventTarget : ICallbackTarget
+	{
+	public:
+		QueuedEventTarget(EventRing ^ring, PyObject *handler) : _ring(ring), _handler(handler)
+		{
+			DeferredRelease::Hold(_handler);
+		}
+
+		~QueuedEventTarget()
+		{
+			this->!QueuedEventTarget();
+		}
+
+		// Runs on CLR finalizer thread, which does not hold the GIL
+		!QueuedEventTarget()
+		{
+			DeferredRelease::Release(_handler);
+			_handler = nullptr;
+		}
+
+		virtual System::Object ^ Invoke(array<System::Object ^> ^args)
+		{
+			_ring->TryEnqueue(this, args);
+			return nullptr;
+		}
+
+		PyObject *GetHandler()
+		{
+			return _handler;
+		}
+
+	private:
+		EventRing ^_ring;
+		PyObject *_handler;
+	};
+
+	// Python handler bound to event queue, i.e. obj.Changed += queue.bind(handler)
+	struct DynamicQueuedHandler
+	{
+		DynamicQueuedHandler(boost::python::object handler, EventRing ^ring) : _handler(handler), _ring(ring)
+		{}
+
+		boost::python::object GetHandler() const
+		{
+			return _handler;
+		}
+
+		EventRing ^GetRing() const
+		{
+			return _ring;
+		}
+
+		// Delegate of given type enqueuing its invocations, or nullptr if delegate returns value or has REF or OUT parameters
+		System::Delegate ^CreateDelegate(System::Type ^handlerType) const;
+
+		static void Register(const std::string &name);
+
+	private:
+		boost::python::object _handler;
+		gcroot<EventRing ^> _ring;
+	};
+
+	// Python side of event queue, which dispatches enqueued invocations to their python handlers.
+	// Dispatch may be run synchronously, or from asyncio loop with wait() run in executor.
+	struct DynamicEventQueue
+	{
+		DynamicEventQueue(int capacity) : _ring(gcnew EventRing(capacity))
+		{}
+
+		DynamicQueuedHandler Bind(boost::python::object handler) const
+		{
+			return DynamicQueuedHandler(handler, _ring);
+		}
+
+		// Calls handlers of up to maxCount pending invocations, or of all pending if maxCount is zero
+		int Dispatch(int maxCount);
+
+		// Waits with the GIL released, and returns True if there are pending invocations
+		bool Wait(double timeout);
+
+		void Close()
+		{
+			_ring->Close();
+		}
+
+		int GetCapacity() const { return _ring->Capacity; }
+		bool IsClosed() const { return _ring->IsClosed; }
+		Int64 GetPending() const { return _ring->Pending; }
+		Int64 GetEnqueued() const { return _ring->Enqueued; }
+		Int64 GetDispatched() const { return _ring->Dispatched; }
+		Int64 GetDropped() const { return _ring->Dropped; }
+
+		static void Register(const std::string &name);
+
+	private:
+		gcroot<EventRing ^> _ring;
+	};
+
+	// Event member bound to instance (or static), which supports += and -= of python callables,
+	// and of handlers bound to event queue.
+	struct DynamicEvent
+	{
+		DynamicEvent(System::Object ^obj, System::Reflection::EventInfo ^ei) : _obj(obj), _ei(ei)
+		{}
+
+		static boost::python::object AddHandler(boost::python::object self, boost::python::object handler);
+
+		static boost::python::object RemoveHandler(boost::python::object self, boost::python::object handler);
+
+		boost::python::str ToString() const;
+
+		static void Register(const std::string &name);
+
+	private:
+		gcroot<System::Object ^> _obj;
+		gcroot<System::Reflection::EventInfo ^> _ei;
+	};
+
+}// namespace InteropPython
+
+#endif // INCLUDED...
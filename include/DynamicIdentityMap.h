@@ -0,0 +1,61 @@
+// The MIT License (MIT) Copyright (c) 2016, Susquehanna International Group
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INCLUDED_PYDOTNET_DYNAMIC_IDENTITY_MAP_H
+#define INCLUDED_PYDOTNET_DYNAMIC_IDENTITY_MAP_H
+
+#include "InteropPythonTypes.h"
+
+namespace InteropPython {
+
+	// Remembers python wrapper returned for managed object, so that same managed object 
+	// is returned as same wrapper for as long as that wrapper is alive, and so 'is' holds 
+	// and attributes set on wrapper survive round trips through managed code.
+	// Neither side is kept alive by the map: entries are keyed by managed object in 
+	// ConditionalWeakTable, and they hold only python weak references to wrappers.
+	struct DynamicIdentityMap
+	{
+		// Returns live wrapper of managed object, or None
+		static boost::python::object Find(System::Object ^obj);
+
+		// Remembers wrapper just created for managed object
+		static void Add(System::Object ^obj, const boost::python::object &wrapper);
+
+		// Number of entries not yet collected along with their managed objects
+		static long GetCount();
+
+		// Highest number of entries at once
+		static long GetPeakCount();
+
+		static bool GetEnabled()
+		{
+			return g_UseIdentityMap;
+		}
+
+		static void SetEnabled(bool enabled)
+		{
+			// Setting this to True makes objects returned from now on remembered
+			g_UseIdentityMap = enabled;
+		}
+	};
+
+}// namespace InteropPython
+
+#endif // INCLUDED...
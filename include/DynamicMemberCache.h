@@ -0,0 +1,93 @@
+// The MIT License (MIT) Copyright (c) 2016, Susquehanna International Group
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef INCLUDED_PYDOTNET_DYNAMIC_MEMBER_CACHE_H
+#define INCLUDED_PYDOTNET_DYNAMIC_MEMBER_CACHE_H
+
+#include "DynamicObjectHandle.h"
+
+namespace InteropPython {
+
+	// Member of managed type resolved by name. Descriptors are resolved once per type and name,
+	// and are shared by all handles of that type, which only bind their instance to them.
+	struct MemberDescriptor : private DynamicObjectDetail
+	{
+		enum Kind
+		{
+			Missing,
+			Property,
+			Field,
+			MethodGroup,
+			NestedType,
+			Event,
+			Other
+		};
+
+		MemberDescriptor(array<MemberInfo ^> ^members);
+
+		Kind GetKind() const
+		{
+			return _kind;
+		}
+
+		array<MemberInfo ^> ^GetMembers() const
+		{
+			return _members;
+		}
+
+		// True for method groups, which contain unspecialized generic methods
+		bool HasGenericMethods() const
+		{
+			return _hasGenericMethods;
+		}
+
+		boost::python::object Bind(System::Object ^obj) const;
+
+	private:
+		Kind _kind;
+		bool _hasGenericMethods;
+		gcroot<array<MemberInfo ^> ^> _members;
+		std::vector<DynamicMethodInvoker> _methods;
+		std::shared_ptr<OverloadCache> _overloadCache;
+
+		// Value that does not depend on instance, i.e. nested type or static method group
+		mutable boost::python::object _unbound;
+	};
+
+	// Process-wide cache of member descriptors keyed by managed type and member name.
+	// Descriptors are never removed, including those of missing members.
+	struct DynamicMemberCache
+	{
+		static const MemberDescriptor &Get(System::Type ^typ, const std::string &name);
+
+		static int GetCount();
+
+	private:
+		typedef std::unordered_map<std::string, MemberDescriptor> TypeMembers;
+		typedef std::unordered_map<intptr_t, TypeMembers> Types;
+
+		static Types *sTypes;
+		static int sCount;
+	};
+
+}// namespace InteropPython
+
+#endif // INCLUDED...
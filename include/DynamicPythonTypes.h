@@ -0,0 +1,95 @@
+// The MIT License (MIT) Copyright (c) 2016, Susquehanna International Group
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef INCLUDED_PYDOTNET_DYNAMIC_PYTHON_TYPES_H
+#define INCLUDED_PYDOTNET_DYNAMIC_PYTHON_TYPES_H
+
+#include "InteropPythonTypes.h"
+#include "ManagedReferences.h"
+
+namespace InteropPython {
+
+	struct MemberDescriptor;
+
+	// Python descriptor giving access to member of managed type. Placed on python type generated 
+	// for managed type, so that attribute lookup is served by python type attribute cache.
+	struct MemberAccessor
+	{
+		MemberAccessor(const MemberDescriptor *member, const std::string &name) : _member(member), _name(name)
+		{}
+
+		boost::python::object Get(boost::python::object obj, boost::python::object type) const;
+
+		std::string GetName() const
+		{
+			return _name;
+		}
+
+		static void Register(const std::string &name, const std::string &dataName);
+
+	protected:
+		const MemberDescriptor *_member;
+		std::string _name;
+	};
+
+	// Descriptor of field or property, which can also be set
+	struct DataMemberAccessor : MemberAccessor
+	{
+		DataMemberAccessor(const MemberDescriptor *member, const std::string &name) : MemberAccessor(member, name)
+		{}
+
+		void Set(boost::python::object obj, boost::python::object value) const;
+	};
+
+	// Python types generated per managed type as subclasses of Interop.Object.
+	// Each type carries descriptors for fields, properties and method groups of managed type.
+	// Members, which need getattr hooks (i.e. generic methods), are left to __getattr__.
+	struct DynamicPythonTypes
+	{
+		static boost::python::object GetType(System::Type ^typ);
+
+		// Switches class of python object to python type generated for given managed type
+		static void Assign(boost::python::object &obj, System::Type ^typ);
+
+		// Number of python types generated so far
+		static int GetCount()
+		{
+			return (sTypes == nullptr ? 0 : (int)sTypes->size());
+		}
+
+		static bool GetEnabled()
+		{
+			return g_UsePythonTypes;
+		}
+
+		static void SetEnabled(bool enabled)
+		{
+			// Setting this to True makes objects returned from now on instances of generated types
+			g_UsePythonTypes = enabled;
+		}
+
+	private:
+		static std::unordered_map<intptr_t, boost::python::object> *sTypes;
+	};
+
+}// namespace InteropPython
+
+#endif // INCLUDED...
@@ -0,0 +1,480 @@
+// The MIT License (MIT) Copyright (c) 2016, Susquehanna International Group
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef INCLUDED_PYDOTNET_DYNAMIC_VIEWS_H
+#define INCLUDED_PYDOTNET_DYNAMIC_VIEWS_H
+
+#include "DynamicObjectHandle.h"
+
+namespace InteropPython {
+
+	// Marks python sequence or mapping to be passed to .NET as lazy view rather than copied, 
+	// i.e. Interop.View([1, 2, 3]) can be passed as IList<int>, IReadOnlyList<int> or IEnumerable<int>, 
+	// and Interop.View({'a': 1}) as IReadOnlyDictionary<string, int>.
+	struct DynamicView
+	{
+		DynamicView(boost::python::object obj) : _obj(obj)
+		{}
+
+		boost::python::object GetObject() const
+		{
+			return _obj;
+		}
+
+		// View over python object for given managed interface type, or nullptr if type is not supported
+		// or python object does not provide sequence or mapping protocol, which view needs, in which case
+		// object is copied instead
+		System::Object ^ CreateView(System::Type ^resultType) const;
+
+		// Type of view implementing given managed interface type, or nullptr if there is none
+		static System::Type ^ GetViewType(System::Type ^resultType);
+
+		// True if python object provides protocol used through given managed interface type
+		static bool Supports(System::Type ^resultType, PyObject *obj);
+
+		static void Register(const std::string &name);
+
+	private:
+		boost::python::object _obj;
+	};
+
+	// Shared parts of managed views holding reference to python object
+	public ref class PythonObjectView abstract
+	{
+	public:
+		~PythonObjectView()
+		{
+			this->!PythonObjectView();
+		}
+
+		// Runs on CLR finalizer thread, which does not hold the GIL
+		!PythonObjectView()
+		{
+			DeferredRelease::Release(_obj);
+			_obj = nullptr;
+		}
+
+	protected:
+		PythonObjectView(System::IntPtr obj) : _obj((PyObject *)obj.ToPointer())
+		{
+			DeferredRelease::Hold(_obj);
+		}
+
+		// Managed exception carrying python error, which is cleared
+		static System::Exception ^ FetchError();
+
+		static System::Object ^ ConvertToManaged(PyObject *item, System::Type ^typ);
+
+		static PyObject * ConvertToPython(System::Object ^value);
+
+		// Number of items fetched by enumerator under single GIL acquisition
+		literal int ChunkSize = 64;
+
+		PyObject *_obj;
+	};
+
+	// Enumerates python iterable in chunks, converting items under single GIL acquisition per chunk
+	generic<typename T>
+	public ref class PythonIteratorView : PythonObjectView, System::Collections::Generic::IEnumerator<T>
+	{
+	public:
+		PythonIteratorView(System::IntPtr iterable) : PythonObjectView(iterable), 
+			_items(gcnew array<T>(ChunkSize)), _count(0), _index(0), _done(false)
+		{}
+
+		virtual bool MoveNext()
+		{
+			if (++_index < _count)
+			{
+				return true;
+			}
+			if (_done)
+			{
+				return false;
+			}
+
+			AcquireGIL lk;
+			if (_iter == nullptr)
+			{
+				_iter = PyObject_GetIter(_obj);
+				if (_iter == nullptr)
+				{
+					throw FetchError();
+				}
+				DeferredRelease::Adopt(_iter);
+			}
+
+			_count = 0;
+			_index = 0;
+			while (_count != ChunkSize)
+			{
+				PyObject *item = PyIter_Next(_iter);
+				if (item == nullptr)
+				{
+					if (PyErr_Occurred())
+					{
+						throw FetchError();
+					}
+					_done = true;
+					break;
+				}
+				try
+				{
+					_items[_count++] = safe_cast<T>(ConvertToManaged(item, T::typeid));
+				}
+				finally
+				{
+					Py_DECREF(item);
+				}
+			}
+			return _count != 0;
+		}
+
+		virtual void Reset()
+		{
+			AcquireGIL lk;
+			DeferredRelease::Release(_iter);
+			_iter = nullptr;
+			_count = 0;
+			_index = 0;
+			_done = false;
+		}
+
+		property T Current
+		{
+			virtual T get()
+			{
+				return _items[_index];
+			}
+		}
+
+		property System::Object ^ CurrentObject
+		{
+			virtual System::Object ^ get() = System::Collections::IEnumerator::Current::get
+			{
+				return _items[_index];
+			}
+		}
+
+		~PythonIteratorView()
+		{
+			this->!PythonIteratorView();
+		}
+
+		!PythonIteratorView()
+		{
+			DeferredRelease::Release(_iter);
+			_iter = nullptr;
+		}
+
+	private:
+		PyObject *_iter;
+		array<T> ^_items;
+		int _count;
+		int _index;
+		bool _done;
+	};
+
+	// Read-only list over python sequence, which converts items on access
+	generic<typename T>
+	public ref class PythonSequenceView : PythonObjectView, 
+		System::Collections::Generic::IList<T>, System::Collections::Generic::IReadOnlyList<T>
+	{
+	public:
+		PythonSequenceView(System::IntPtr sequence) : PythonObjectView(sequence)
+		{}
+
+		property T default[int]
+		{
+			virtual T get(int index)
+			{
+				// Negative index is not counted from the end, as python would do
+				if (index < 0)
+				{
+					throw gcnew System::ArgumentOutOfRangeException("index");
+				}
+
+				AcquireGIL lk;
+				Py_ssize_t n = PySequence_Size(_obj);
+				if (n < 0)
+				{
+					throw FetchError();
+				}
+				if (index >= n)
+				{
+					throw gcnew System::ArgumentOutOfRangeException("index");
+				}
+
+				PyObject *item = PySequence_GetItem(_obj, index);
+				if (item == nullptr)
+				{
+					// Sequence may have shrunk meanwhile, or may report length it does not have
+					if (PyErr_ExceptionMatches(PyExc_IndexError))
+					{
+						PyErr_Clear();
+						throw gcnew System::ArgumentOutOfRangeException("index");
+					}
+					throw FetchError();
+				}
+				try
+				{
+					return safe_cast<T>(ConvertToManaged(item, T::typeid));
+				}
+				finally
+				{
+					Py_DECREF(item);
+				}
+			}
+
+			virtual void set(int index, T value)
+			{
+				throw gcnew System::NotSupportedException("View of python sequence is read-only");
+			}
+		}
+
+		property int Count
+		{
+			virtual int get()
+			{
+				AcquireGIL lk;
+				Py_ssize_t n = PySequence_Size(_obj);
+				if (n < 0)
+				{
+					throw FetchError();
+				}
+				return (int)n;
+			}
+		}
+
+		property bool IsReadOnly
+		{
+			virtual bool get()
+			{
+				return true;
+			}
+		}
+
+		virtual int IndexOf(T item)
+		{
+			int i = 0;
+			for each (T x in this)
+			{
+				if (System::Collections::Generic::EqualityComparer<T>::Default->Equals(x, item))
+				{
+					return i;
+				}
+				++i;
+			}
+			return -1;
+		}
+
+		virtual bool Contains(T item)
+		{
+			return IndexOf(item) != -1;
+		}
+
+		virtual void CopyTo(array<T> ^items, int arrayIndex)
+		{
+			for each (T x in this)
+			{
+				items[arrayIndex++] = x;
+			}
+		}
+
+		virtual void Insert(int index, T item)
+		{
+			throw gcnew System::NotSupportedException("View of python sequence is read-only");
+		}
+
+		virtual void RemoveAt(int index)
+		{
+			throw gcnew System::NotSupportedException("View of python sequence is read-only");
+		}
+
+		virtual void Add(T item)
+		{
+			throw gcnew System::NotSupportedException("View of python sequence is read-only");
+		}
+
+		virtual void Clear()
+		{
+			throw gcnew System::NotSupportedException("View of python sequence is read-only");
+		}
+
+		virtual bool Remove(T item)
+		{
+			throw gcnew System::NotSupportedException("View of python sequence is read-only");
+		}
+
+		virtual System::Collections::Generic::IEnumerator<T> ^ GetEnumerator()
+		{
+			return gcnew PythonIteratorView<T>(System::IntPtr(_obj));
+		}
+
+		virtual System::Collections::IEnumerator ^ GetEnumeratorObject() = System::Collections::IEnumerable::GetEnumerator
+		{
+			return GetEnumerator();
+		}
+	};
+
+	// Read-only dictionary over python mapping, which converts keys and values on access
+	generic<typename K, typename V>
+	public ref class PythonMappingView : PythonObjectView, 
+		System::Collections::Generic::IReadOnlyDictionary<K, V>
+	{
+		typedef System::Collections::Generic::KeyValuePair<K, V> Pair;
+
+	public:
+		PythonMappingView(System::IntPtr mapping) : PythonObjectView(mapping)
+		{}
+
+		property V default[K]
+		{
+			virtual V get(K key)
+			{
+				V value;
+				if (!TryGetValue(key, value))
+				{
+					throw gcnew System::Collections::Generic::KeyNotFoundException();
+				}
+				return value;
+			}
+		}
+
+		property int Count
+		{
+			virtual int get()
+			{
+				AcquireGIL lk;
+				Py_ssize_t n = PyMapping_Size(_obj);
+				if (n < 0)
+				{
+					throw FetchError();
+				}
+				return (int)n;
+			}
+		}
+
+		property System::Collections::Generic::IEnumerable<K> ^ Keys
+		{
+			virtual System::Collections::Generic::IEnumerable<K> ^ get()
+			{
+				AcquireGIL lk;
+				PyObject *keys = PyMapping_Keys(_obj);
+				if (keys == nullptr)
+				{
+					throw FetchError();
+				}
+				try
+				{
+					return gcnew PythonSequenceView<K>(System::IntPtr(keys));
+				}
+				finally
+				{
+					Py_DECREF(keys);
+				}
+			}
+		}
+
+		property System::Collections::Generic::IEnumerable<V> ^ Values
+		{
+			virtual System::Collections::Generic::IEnumerable<V> ^ get()
+			{
+				AcquireGIL lk;
+				PyObject *values = PyMapping_Values(_obj);
+				if (values == nullptr)
+				{
+					throw FetchError();
+				}
+				try
+				{
+					return gcnew PythonSequenceView<V>(System::IntPtr(values));
+				}
+				finally
+				{
+					Py_DECREF(values);
+				}
+			}
+		}
+
+		virtual bool ContainsKey(K key)
+		{
+			AcquireGIL lk;
+			PyObject *pyKey = ConvertToPython(key);
+			int found = PyMapping_HasKey(_obj, pyKey);
+			Py_DECREF(pyKey);
+			return found != 0;
+		}
+
+		virtual bool TryGetValue(K key, [System::Runtime::InteropServices::Out] V %value)
+		{
+			AcquireGIL lk;
+			PyObject *pyKey = ConvertToPython(key);
+			PyObject *item = PyObject_GetItem(_obj, pyKey);
+			Py_DECREF(pyKey);
+			if (item == nullptr)
+			{
+				if (!PyErr_ExceptionMatches(PyExc_KeyError))
+				{
+					throw FetchError();
+				}
+				PyErr_Clear();
+				value = V();
+				return false;
+			}
+			try
+			{
+				value = safe_cast<V>(ConvertToManaged(item, V::typeid));
+			}
+			finally
+			{
+				Py_DECREF(item);
+			}
+			return true;
+		}
+
+		virtual System::Collections::Generic::IEnumerator<Pair> ^ GetEnumerator()
+		{
+			AcquireGIL lk;
+			PyObject *items = PyMapping_Items(_obj);
+			if (items == nullptr)
+			{
+				throw FetchError();
+			}
+			try
+			{
+				return gcnew PythonIteratorView<Pair>(System::IntPtr(items));
+			}
+			finally
+			{
+				Py_DECREF(items);
+			}
+		}
+
+		virtual System::Collections::IEnumerator ^ GetEnumeratorObject() = System::Collections::IEnumerable::GetEnumerator
+		{
+			return GetEnumerator();
+		}
+	};
+
+}// namespace InteropPython
+
+#endif // INCLUDED...
@@ -1,131 +1,190 @@
-// The MIT License (MIT) Copyright (c) 2016, Susquehanna International Group
-// 
-// Permission is hereby granted, free of charge, to any person obtaining a copy of
-// this software and associated documentation files (the "Software"), to deal in
-// the Software without restriction, including without limitation the rights to
-// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
-// of the Software, and to permit persons to whom the Software is furnished to do
-// so, subject to the following conditions:
-// 
-// The above copyright notice and this permission notice shall be included in all
-// copies or substantial portions of the Software.
-// 
-// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
-// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
-// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
-// SOFTWARE.
-
-#ifndef INCLUDED_PYDOTNET_INTEROP_PYTHON_TYPES_H
-#define INCLUDED_PYDOTNET_INTEROP_PYTHON_TYPES_H
-#pragma managed(push)
-#pragma unmanaged
-
-#include <boost/function.hpp>
-//#include <boost/algorithm/string_regex.hpp>
-#include <boost/concept_check.hpp>
-#include <boost/python.hpp>
-#include <boost/python/slice.hpp>
-#include <boost/python/str.hpp>
-#include <boost/algorithm/string/predicate.hpp>
-#include <memory>
-#include <vector>
-#include <list>
-#include <map>
-#include <unordered_map>
-#include <set>
-
-
-namespace InteropPython {
-
-	extern bool g_DebugModuleInit;
-	extern bool g_DebugDynamicInvokes;
-	
-	inline bool hasattr(boost::python::object obj, std::string const &attrName) 
-	{
-		return PyObject_HasAttrString(obj.ptr(), attrName.c_str());
-	}
-
-	inline std::string FriendlyTypename(const std::string& s)
-	{
-		return s;//boost::regex_replace(s, boost::regex("([,<])"), "\\1\n\t");
-	}
-
-	template<typename T>
-	inline std::string FriendlyTypename()
-	{
-		return FriendlyTypename(typeid(T).name());
-	}
-
-	template<typename T>
-	inline boost::python::object Repr(const T &x)
-	{
-		boost::python::object obj(x);
-		PyObject *pobj = obj.ptr();
-		PyObject *pres = PyObject_Repr(pobj);
-		return boost::python::object(boost::python::detail::new_reference(pres));
-	}
-
-	template<typename T>
-	inline std::string ReprString(const T &x)
-	{
-		boost::python::object r = Repr(x);
-		return boost::python::extract<std::string>(x);
-	}
-
-	// It is VERY important to note that you MUST NOT touch any python code, or 
-	// python data or call in to the interpreter while not holding the GIL. 
-	// This will cause your interpreter to crash.
-	// http://stackoverflow.com/questions/8009613/boost-python-not-supporting-parallelism
-	struct AcquireGIL
-	{
-		AcquireGIL()
-		{
-			_state = PyGILState_Ensure();
-		}
-
-		~AcquireGIL()
-		{
-			PyGILState_Release(_state);
-		}
-
-	private:
-		PyGILState_STATE _state;
-	};
-
-	// One of the advantages of Boost.Python is that you can release the GIL, do C++ stuff, 
-	// and then take it back when you are done.
-	struct ReleaseGIL
-	{
-		ReleaseGIL()
-		{
-			_state = PyEval_SaveThread();
-		}
-
-		~ReleaseGIL()
-		{
-			PyEval_RestoreThread(_state);
-		}
-
-	private:
-		PyThreadState *_state;
-	};
-
-	typedef unsigned __int64 UInt64;
-	typedef unsigned __int32 UInt32;
-	typedef unsigned __int16 UInt16;
-	typedef unsigned __int8 UInt8;
-	typedef __int64 Int64;
-	typedef __int32 Int32;
-	typedef __int16 Int16;
-	typedef __int8 Int8;
-	typedef double Double;
-	typedef float Single;
-	typedef bool Boolean;
-
-} // namespace InteropPython
-
-#pragma managed(pop)
-#endif // INCLUDED...
+// The MIT License (MIT) Copyright (c) 2016, Susquehanna International Group
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INCLUDED_PYDOTNET_INTEROP_PYTHON_TYPES_H
+#define INCLUDED_PYDOTNET_INTEROP_PYTHON_TYPES_H
+#pragma managed(push)
+#pragma unmanaged
+
+#include <boost/function.hpp>
+//#include <boost/algorithm/string_regex.hpp>
+#include <boost/concept_check.hpp>
+#include <boost/python.hpp>
+#include <boost/python/slice.hpp>
+#include <boost/python/str.hpp>
+#include <boost/algorithm/string/predicate.hpp>
+#include <memory>
+#include <vector>
+#include <list>
+#include <map>
+#include <unordered_map>
+#include <set>
+
+
+namespace InteropPython {
+
+	extern bool g_DebugModuleInit;
+	extern bool g_DebugDynamicInvokes;
+	extern bool g_UseCompiledInvokers;
+	extern bool g_UsePythonTypes;
+	extern int g_IteratorBatchSize;
+	extern bool g_UseIdentityMap;
+	
+	inline bool hasattr(boost::python::object obj, std::string const &attrName) 
+	{
+		return PyObject_HasAttrString(obj.ptr(), attrName.c_str());
+	}
+
+	inline std::string FriendlyTypename(const std::string& s)
+	{
+		return s;//boost::regex_replace(s, boost::regex("([,<])"), "\\1\n\t");
+	}
+
+	template<typename T>
+	inline std::string FriendlyTypename()
+	{
+		return FriendlyTypename(typeid(T).name());
+	}
+
+	template<typename T>
+	inline boost::python::object Repr(const T &x)
+	{
+		boost::python::object obj(x);
+		PyObject *pobj = obj.ptr();
+		PyObject *pres = PyObject_Repr(pobj);
+		return boost::python::object(boost::python::detail::new_reference(pres));
+	}
+
+	template<typename T>
+	inline std::string ReprString(const T &x)
+	{
+		boost::python::object r = Repr(x);
+		return boost::python::extract<std::string>(x);
+	}
+
+	// References to python objects held by managed wrappers (callback proxies, views), 
+	// which may be released by threads not holding the GIL, i.e. by CLR finalizer thread.
+	// Such references are pushed onto lock-free stack, and are released in single batch
+	// by the next thread, which acquires the GIL.
+	struct DeferredRelease
+	{
+		// Takes new reference to object for wrapper, must be called with the GIL held
+		static void Hold(PyObject *obj);
+
+		// Takes over reference already owned by wrapper, i.e. returned by PyObject_GetIter()
+		static void Adopt(PyObject *obj);
+
+		// Releases reference held by wrapper, may be called from any thread
+		static void Release(PyObject *obj);
+
+		// Releases references pushed so far, must be called with the GIL held
+		static void Drain()
+		{
+			if (sHead != nullptr)
+			{
+				DrainAll();
+			}
+		}
+
+		// Number of references currently held by wrappers
+		static long GetHeldCount();
+
+		// Highest number of references held by wrappers at once
+		static long GetHeldPeakCount();
+
+		// Number of references waiting for the GIL to be released
+		static long GetPendingCount();
+
+	private:
+		struct Node
+		{
+			PyObject *obj;
+			Node *next;
+		};
+
+		static void DrainAll();
+
+		static Node * volatile sHead;
+		static volatile long sHeld;
+		static volatile long sHeldPeak;
+		static volatile long sPending;
+	};
+
+	// It is VERY important to note that you MUST NOT touch any python code, or 
+	// python data or call in to the interpreter while not holding the GIL. 
+	// This will cause your interpreter to crash.
+	// http://stackoverflow.com/questions/8009613/boost-python-not-supporting-parallelism
+	struct AcquireGIL
+	{
+		AcquireGIL()
+		{
+			_state = PyGILState_Ensure();
+			DeferredRelease::Drain();
+		}
+
+		~AcquireGIL()
+		{
+			PyGILState_Release(_state);
+		}
+
+	private:
+		PyGILState_STATE _state;
+	};
+
+	// One of the advantages of Boost.Python is that you can release the GIL, do C++ stuff, 
+	// and then take it back when you are done.
+	// GIL may be kept for the scope, i.e. when callbacks into python are expected on this 
+	// thread, as then AcquireGIL finds it already held and does not need to wait for it.
+	struct ReleaseGIL
+	{
+		explicit ReleaseGIL(bool release = true)
+		{
+			_state = release ? PyEval_SaveThread() : nullptr;
+		}
+
+		~ReleaseGIL()
+		{
+			if (_state != nullptr)
+			{
+				PyEval_RestoreThread(_state);
+				DeferredRelease::Drain();
+			}
+		}
+
+	private:
+		PyThreadState *_state;
+	};
+
+	typedef unsigned __int64 UInt64;
+	typedef unsigned __int32 UInt32;
+	typedef unsigned __int16 UInt16;
+	typedef unsigned __int8 UInt8;
+	typedef __int64 Int64;
+	typedef __int32 Int32;
+	typedef __int16 Int16;
+	typedef __int8 Int8;
+	typedef double Double;
+	typedef float Single;
+	typedef bool Boolean;
+
+} // namespace InteropPython
+
+#pragma managed(pop)
+#endif // INCLUDED...
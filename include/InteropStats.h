@@ -0,0 +1,45 @@
+// The MIT License (MIT) Copyright (c) 2016, Susquehanna International Group
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INCLUDED_PYDOTNET_INTEROP_STATS_H
+#define INCLUDED_PYDOTNET_INTEROP_STATS_H
+
+#include "InteropPythonTypes.h"
+
+namespace InteropPython {
+
+	// Accounting of references and caches held by module, i.e. for leak hunting in long running processes.
+	// Caches never shrink, so that their sizes are also their high-water marks.
+	struct InteropStats
+	{
+		// Returns dict of live counts with their high-water marks (suffixed with _peak), sizes of caches,
+		// and size of managed heap with numbers of collections per generation. While handle sites are 
+		// tracked, 'handle_sites' maps creation site and type of object to number of outstanding handles.
+		static boost::python::dict GetStats();
+
+		static bool GetTrackHandleSites();
+
+		// Setting this to True records python source line, which allocates each handle from now on
+		static void SetTrackHandleSites(bool enabled);
+	};
+
+}// namespace InteropPython
+
+#endif // INCLUDED...
@@ -1,80 +1,581 @@
-// The MIT License (MIT) Copyright (c) 2016, Susquehanna International Group
-// 
-// Permission is hereby granted, free of charge, to any person obtaining a copy of
-// this software and associated documentation files (the "Software"), to deal in
-// the Software without restriction, including without limitation the rights to
-// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
-// of the Software, and to permit persons to whom the Software is furnished to do
-// so, subject to the following conditions:
-// 
-// The above copyright notice and this permission notice shall be included in all
-// copies or substantial portions of the Software.
-// 
-// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
-// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
-// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
-// SOFTWARE.
-
-#ifndef INCLUDED_PYDOTNET_MANAGED_REFERENCES_H
-#define INCLUDED_PYDOTNET_MANAGED_REFERENCES_H
-#pragma managed(push)
-#pragma managed
-
-#using <System.Core.dll>
-#using <System.Data.dll>
-#using <Microsoft.CSharp.dll>
-
-#include <vcclr.h>
-#include <msclr\marshal_cppstd.h>
-
-namespace InteropPython 
-{
-	using System::Enum;
-	using System::Convert;
-	using System::Collections::Generic::IEnumerator;
-	using System::Collections::Generic::IEnumerable;
-	using System::Collections::Generic::IList;
-	using System::Collections::Generic::List;
-	using System::Collections::Generic::IDictionary;
-	using System::Collections::Generic::Dictionary;
-
-	generic<class T> public ref class ImplicitConversion
-	{
-	public:
-		static T Convert(T item)
-		{
-			// Implicit conversion will take Python object and turn it into .NET object.
-			// For implicit convertion to work we need static function Convert(), the 
-			// invocation of which will trigger type conversion.
-			return item;
-		}
-	};
-
-	generic<class T> public ref class ArrayHelper
-	{
-	public:
-		static array<T> ^ CreateArray(int size)
-		{
-			return gcnew array<T>(size);
-		}
-
-		static array<T> ^ GetArray(array<T> ^elements)
-		{
-			// Implicit conversion will take Python list and turn it into array<T^>.
-			// For implicit convertion to work we need static function GetArray(), the 
-			// invocation of which will trigger type conversion.
-			return elements;
-		}
-
-		static System::Type ^ GetArrayType()
-		{
-			return array<T>::typeid;
-		}
-	};
-}
-
-#pragma managed(pop)
-#endif // INCLUDED...
+// The MIT License (MIT) Copyright (c) 2016, Susquehanna International Group
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INCLUDED_PYDOTNET_MANAGED_REFERENCES_H
+#define INCLUDED_PYDOTNET_MANAGED_REFERENCES_H
+#pragma managed(push)
+#pragma managed
+
+#using <System.Core.dll>
+#using <System.Data.dll>
+#using <Microsoft.CSharp.dll>
+
+#include <vcclr.h>
+#include <utility>
+#include <msclr\marshal_cppstd.h>
+
+namespace InteropPython 
+{
+	using System::Enum;
+	using System::Convert;
+	using System::Collections::Generic::IEnumerator;
+	using System::Collections::Generic::IEnumerable;
+	using System::Collections::Generic::IList;
+	using System::Collections::Generic::List;
+	using System::Collections::Generic::IDictionary;
+	using System::Collections::Generic::Dictionary;
+
+	// Process-wide table of strong references to managed objects, which native code holds by slot index.
+	// Released slots are recycled via free list, so that holding a reference costs an array store rather
+	// than allocating and freeing GCHandle, as gcroot does. Slots are grouped in pages, which never move,
+	// so that reading a slot needs no lock.
+	// Each allocation and each assignment bumps generation of its slot, so that slot remembered by HandleScope 
+	// is recognised as holding another reference since.
+	ref class HandleTable abstract sealed
+	{
+	public:
+		static int Alloc(System::Object ^obj)
+		{
+			// Site is taken before the lock, as it may call into python
+			System::Func<System::String ^> ^siteOf = _siteOf;
+			System::String ^site = (siteOf != nullptr ? siteOf() : nullptr);
+
+			System::Threading::Monitor::Enter(_lock);
+			try
+			{
+				int slot;
+				if (_free->Count != 0)
+				{
+					slot = _free->Pop();
+				}
+				else
+				{
+					slot = _count++;
+					if ((slot >> PageBits) == _pages->Length)
+					{
+						array<array<System::Object ^> ^> ^pages = gcnew array<array<System::Object ^> ^>(_pages->Length * 2);
+						System::Array::Copy(_pages, pages, _pages->Length);
+						_pages = pages;
+						array<array<int> ^> ^generations = gcnew array<array<int> ^>(_generations->Length * 2);
+						System::Array::Copy(_generations, generations, _generations->Length);
+						_generations = generations;
+					}
+					if (_pages[slot >> PageBits] == nullptr)
+					{
+						_pages[slot >> PageBits] = gcnew array<System::Object ^>(PageSize);
+						_generations[slot >> PageBits] = gcnew array<int>(PageSize);
+					}
+				}
+				_pages[slot >> PageBits][slot & PageMask] = obj;
+				++_generations[slot >> PageBits][slot & PageMask];
+				if (_sites != nullptr)
+				{
+					_sites[slot] = (site != nullptr ? site : "<unknown>");
+				}
+				if (_count - _free->Count > _peak)
+				{
+					_peak = _count - _free->Count;
+				}
+				return slot;
+			}
+			finally
+			{
+				System::Threading::Monitor::Exit(_lock);
+			}
+		}
+
+		static void Free(int slot)
+		{
+			System::Threading::Monitor::Enter(_lock);
+			try
+			{
+				if (_pages[slot >> PageBits][slot & PageMask] == nullptr)
+				{
+					--_detached;
+				}
+				_pages[slot >> PageBits][slot & PageMask] = nullptr;
+				_free->Push(slot);
+				if (_sites != nullptr)
+				{
+					_sites->Remove(slot);
+				}
+			}
+			finally
+			{
+				System::Threading::Monitor::Exit(_lock);
+			}
+		}
+
+		static System::Object ^ Get(int slot)
+		{
+			return _pages[slot >> PageBits][slot & PageMask];
+		}
+
+		// Replaces reference held by slot. Slot cleared by Detach stays cleared until freed, 
+		// so that handle released by HandleScope cannot be revived.
+		static void Set(int slot, System::Object ^obj)
+		{
+			System::Threading::Monitor::Enter(_lock);
+			try
+			{
+				if (_pages[slot >> PageBits][slot & PageMask] == nullptr)
+				{
+					throw gcnew System::InvalidOperationException("Reference released by handle scope cannot be assigned");
+				}
+				_pages[slot >> PageBits][slot & PageMask] = obj;
+				++_generations[slot >> PageBits][slot & PageMask];
+			}
+			finally
+			{
+				System::Threading::Monitor::Exit(_lock);
+			}
+		}
+
+		static int GetGeneration(int slot)
+		{
+			return _generations[slot >> PageBits][slot & PageMask];
+		}
+
+		// Clears slot, unless it was freed and allocated again since given generation, and returns 
+		// object it held. Slot itself stays owned by its ManagedHandle, which frees it as usual.
+		static System::Object ^ Detach(int slot, int generation)
+		{
+			System::Threading::Monitor::Enter(_lock);
+			try
+			{
+				if (_generations[slot >> PageBits][slot & PageMask] != generation)
+				{
+					return nullptr;
+				}
+				System::Object ^obj = _pages[slot >> PageBits][slot & PageMask];
+				if (obj != nullptr)
+				{
+					_pages[slot >> PageBits][slot & PageMask] = nullptr;
+					++_detached;
+				}
+				return obj;
+			}
+			finally
+			{
+				System::Threading::Monitor::Exit(_lock);
+			}
+		}
+
+		// Number of slots currently holding references, which excludes slots cleared by Detach
+		static int GetCount()
+		{
+			return _count - _free->Count - _detached;
+		}
+
+		// Highest number of slots holding references at once
+		static int GetPeakCount()
+		{
+			return _peak;
+		}
+
+		// Number of slots allocated so far, whether holding references or free
+		static int GetCapacity()
+		{
+			return _count;
+		}
+
+		// Starts recording creation site of each slot allocated from now on, as given by siteOf, 
+		// or stops recording, if siteOf is nullptr.
+		static void TrackSites(System::Func<System::String ^> ^siteOf)
+		{
+			System::Threading::Monitor::Enter(_lock);
+			try
+			{
+				_siteOf = siteOf;
+				_sites = (siteOf != nullptr ? gcnew Dictionary<int, System::String ^>() : nullptr);
+			}
+			finally
+			{
+				System::Threading::Monitor::Exit(_lock);
+			}
+		}
+
+		static bool IsTrackingSites()
+		{
+			return _siteOf != nullptr;
+		}
+
+		// Numbers of slots holding references, keyed by creation site and type of object held
+		static Dictionary<System::String ^, int> ^ GetSites()
+		{
+			Dictionary<System::String ^, int> ^counts = gcnew Dictionary<System::String ^, int>();
+
+			System::Threading::Monitor::Enter(_lock);
+			try
+			{
+				if (_sites == nullptr)
+				{
+					return counts;
+				}
+				for each (System::Collections::Generic::KeyValuePair<int, System::String ^> site in _sites)
+				{
+					System::Object ^obj = Get(site.Key);
+					System::String ^key = site.Value + ": " + (obj == nullptr ? "null" : obj->GetType()->FullName);
+					int count;
+					counts->TryGetValue(key, count);
+					counts[key] = count + 1;
+				}
+				return counts;
+			}
+			finally
+			{
+				System::Threading::Monitor::Exit(_lock);
+			}
+		}
+
+	private:
+		static HandleTable()
+		{
+			_lock = gcnew System::Object();
+			_pages = gcnew array<array<System::Object ^> ^>(16);
+			_generations = gcnew array<array<int> ^>(16);
+			_free = gcnew System::Collections::Generic::Stack<int>();
+			_count = 0;
+			_peak = 0;
+			_detached = 0;
+		}
+
+		literal int PageBits = 12;
+		literal int PageSize = 1 << PageBits;
+		literal int PageMask = PageSize - 1;
+
+		static System::Object ^_lock;
+		static array<array<System::Object ^> ^> ^_pages;
+		static array<array<int> ^> ^_generations;
+		static System::Collections::Generic::Stack<int> ^_free;
+		static int _count;
+		static int _peak;
+		static int _detached;
+		static System::Func<System::String ^> ^_siteOf;
+		static Dictionary<int, System::String ^> ^_sites;
+	};
+
+	// Records slots of handles allocated while scope is active on this thread, including wrappers returned 
+	// to python and methods bound to instances, and clears them all on close, so that managed objects need 
+	// not wait for python to collect their wrappers. Handles of types, members and strings are not recorded, 
+	// as they are kept by caches, which outlive the scope.
+	// Wrappers escaping the scope are left holding null. Scopes nest, and must be closed innermost first,
+	// except for scopes abandoned without being closed, which are skipped once they are no longer current.
+	ref class HandleScope sealed
+	{
+	public:
+		HandleScope(bool dispose) : _dispose(dispose), _closed(false), _outer(_current)
+		{
+			_slots = gcnew List<int>();
+			_generations = gcnew List<int>();
+			_current = this;
+		}
+
+		static bool IsActive()
+		{
+			return Current() != nullptr;
+		}
+
+		static void Track(int slot)
+		{
+			HandleScope ^current = Current();
+			if (slot < 0 || current == nullptr)
+			{
+				return;
+			}
+
+			// Wrapper is recorded when allocated, and again when returned to python
+			int generation = HandleTable::GetGeneration(slot);
+			int last = current->_slots->Count - 1;
+			if (last >= 0 && current->_slots[last] == slot && current->_generations[last] == generation)
+			{
+				return;
+			}
+			current->_slots->Add(slot);
+			current->_generations->Add(generation);
+		}
+
+		// Records slot allocated for given object, unless object is kept by caches
+		static void TrackAllocated(int slot, System::Object ^obj)
+		{
+			if (_current == nullptr
+				|| dynamic_cast<System::Reflection::MemberInfo ^>(obj) != nullptr 
+				|| dynamic_cast<System::String ^>(obj) != nullptr
+				|| dynamic_cast<HandleScope ^>(obj) != nullptr)
+			{
+				return;
+			}
+			Track(slot);
+		}
+
+		// Number of recorded slots, which still hold references they were recorded with
+		int GetCount()
+		{
+			int count = 0;
+			for (int i = 0; i != _slots->Count; ++i)
+			{
+				if (HandleTable::GetGeneration(_slots[i]) == _generations[i] && HandleTable::Get(_slots[i]) != nullptr)
+				{
+					++count;
+				}
+			}
+			return count;
+		}
+
+		// Clears recorded slots, disposing objects they held if requested, and returns number of slots cleared.
+		// All slots are cleared even if disposing some object fails, and then the first failure is rethrown.
+		int Close()
+		{
+			if (_closed)
+			{
+				return 0;
+			}
+			if (Current() != this)
+			{
+				throw gcnew System::InvalidOperationException("Handle scopes must be closed innermost first");
+			}
+
+			_current = _outer;
+			_closed = true;
+			return Release();
+		}
+
+		// Closes scope, which is dropped without being closed, i.e. when its python object is collected
+		// before __exit__. Scope may be outer to scopes still open, or current on other thread, in which
+		// case it is only marked closed here, and is skipped by Current() when it is reached.
+		// Dispose failures are ignored, as there is nobody left to report them to.
+		void Abandon()
+		{
+			if (_closed)
+			{
+				return;
+			}
+			if (Current() == this)
+			{
+				_current = _outer;
+			}
+			_closed = true;
+
+			try
+			{
+				Release();
+			}
+			catch (System::Exception ^)
+			{
+			}
+		}
+
+	private:
+		// Innermost scope, which is still open on this thread
+		static HandleScope ^Current()
+		{
+			while (_current != nullptr && _current->_closed)
+			{
+				_current = _current->_outer;
+			}
+			return _current;
+		}
+
+		int Release()
+		{
+			int released = 0;
+			System::Exception ^failure = nullptr;
+			for (int i = 0; i != _slots->Count; ++i)
+			{
+				System::Object ^obj = HandleTable::Detach(_slots[i], _generations[i]);
+				if (obj == nullptr)
+				{
+					continue;
+				}
+				++released;
+
+				System::IDisposable ^disposable = dynamic_cast<System::IDisposable ^>(obj);
+				if (_dispose && disposable != nullptr)
+				{
+					try
+					{
+						disposable->Dispose();
+					}
+					catch (System::Exception ^err)
+					{
+						if (failure == nullptr)
+						{
+							failure = err;
+						}
+					}
+				}
+			}
+
+			_slots->Clear();
+			_generations->Clear();
+
+			if (failure != nullptr)
+			{
+				throw failure;
+			}
+			return released;
+		}
+
+		bool _dispose;
+		bool _closed;
+		HandleScope ^_outer;
+		List<int> ^_slots;
+		List<int> ^_generations;
+
+		[System::ThreadStatic]
+		static HandleScope ^_current;
+	};
+
+	// Drop-in replacement of gcroot<T>, which holds its reference in HandleTable, 
+	// and can be moved without touching the table at all.
+	template<typename T> class ManagedHandle
+	{
+	public:
+		ManagedHandle() : _slot(-1)
+		{}
+
+		ManagedHandle(T obj) : _slot(-1)
+		{
+			if (obj != nullptr)
+			{
+				Alloc(obj);
+			}
+		}
+
+		// Slot is allocated only for non-null object, as null slots are counted as detached on free
+		ManagedHandle(const ManagedHandle &other) : _slot(-1)
+		{
+			System::Object ^obj = (other._slot < 0 ? nullptr : HandleTable::Get(other._slot));
+			if (obj != nullptr)
+			{
+				Alloc(obj);
+			}
+		}
+
+		ManagedHandle(ManagedHandle &&other) noexcept : _slot(other._slot)
+		{
+			other._slot = -1;
+		}
+
+		~ManagedHandle()
+		{
+			if (_slot >= 0)
+			{
+				HandleTable::Free(_slot);
+			}
+		}
+
+		ManagedHandle &operator = (T obj)
+		{
+			if (obj == nullptr)
+			{
+				ManagedHandle().Swap(*this);
+			}
+			else if (_slot < 0)
+			{
+				Alloc(obj);
+			}
+			else
+			{
+				HandleTable::Set(_slot, obj);
+				HandleScope::TrackAllocated(_slot, obj);
+			}
+			return *this;
+		}
+
+		ManagedHandle &operator = (const ManagedHandle &other)
+		{
+			return (*this = static_cast<T>(other));
+		}
+
+		ManagedHandle &operator = (ManagedHandle &&other) noexcept
+		{
+			ManagedHandle tmp(std::move(other));
+			tmp.Swap(*this);
+			return *this;
+		}
+
+		void Swap(ManagedHandle &other) noexcept
+		{
+			std::swap(_slot, other._slot);
+		}
+
+		operator T () const
+		{
+			return (_slot < 0 ? nullptr : static_cast<T>(HandleTable::Get(_slot)));
+		}
+
+		T operator -> () const
+		{
+			return static_cast<T>(*this);
+		}
+
+		int GetSlot() const
+		{
+			return _slot;
+		}
+
+	private:
+		void Alloc(System::Object ^obj)
+		{
+			_slot = HandleTable::Alloc(obj);
+			HandleScope::TrackAllocated(_slot, obj);
+		}
+
+		int _slot;
+	};
+
+	generic<class T> public ref class ImplicitConversion
+	{
+	public:
+		static T Convert(T item)
+		{
+			// Implicit conversion will take Python object and turn it into .NET object.
+			// For implicit convertion to work we need static function Convert(), the 
+			// invocation of which will trigger type conversion.
+			return item;
+		}
+	};
+
+	generic<class T> public ref class ArrayHelper
+	{
+	public:
+		static array<T> ^ CreateArray(int size)
+		{
+			return gcnew array<T>(size);
+		}
+
+		static array<T> ^ GetArray(array<T> ^elements)
+		{
+			// Implicit conversion will take Python list and turn it into array<T^>.
+			// For implicit convertion to work we need static function GetArray(), the 
+			// invocation of which will trigger type conversion.
+			return elements;
+		}
+
+		static System::Type ^ GetArrayType()
+		{
+			return array<T>::typeid;
+		}
+	};
+}
+
+#pragma managed(pop)
+#endif // INCLUDED...
@@ -1,107 +1,263 @@
-// The MIT License (MIT) Copyright (c) 2016, Susquehanna International Group
-// 
-// Permission is hereby granted, free of charge, to any person obtaining a copy of
-// this software and associated documentation files (the "Software"), to deal in
-// the Software without restriction, including without limitation the rights to
-// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
-// of the Software, and to permit persons to whom the Software is furnished to do
-// so, subject to the following conditions:
-// 
-// The above copyright notice and this permission notice shall be included in all
-// copies or substantial portions of the Software.
-// 
-// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
-// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
-// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
-// SOFTWARE.
-
-#ifndef INCLUDED_PYDOTNET_TYPE_CONVERTER_SPECIALIZATIONS_H
-#define INCLUDED_PYDOTNET_TYPE_CONVERTER_SPECIALIZATIONS_H
-
-#include "DynamicObjectHandle.h"
-
-namespace InteropPython {
-
-	////////////////////////////////////////////////////////
-	//
-	// SPECIALIZED FROM MANAGED TO UNMANAGED TYPE CONVERTERS
-	//
-
-	// Specialized type converter
-	// Managed string --> C++ std::string
-	template<> struct FromManagedTypeConverter<System::String ^, std::string> : TypeConverterBase<System::String ^, std::string>
-	{
-		static ToType Convert(System::Object ^value)
-		{
-			if (value == nullptr)
-				throw_null_reference(FriendlyTypename<FromManagedTypeConverter>() + "::Convert(null) not allowed!");
-			try
-			{
-				FromType fromValue = safe_cast<FromType>(value);
-				ToType toValue = ConvertToUnmanaged(fromValue);
-				return toValue;
-			}
-			catch(System::Exception ^err)
-			{
-				throw_invalid_cast(FriendlyTypename<FromManagedTypeConverter>() + "::Convert(null) failed!\n" + 
-					ConvertToUnmanaged(err->ToString()));
-				throw;
-			}
-		}
-	};
-
-	// Specialized type converter
-	// Managed object --> python object
-	template<> struct FromManagedTypeConverter<System::Object ^, boost::python::object> : TypeConverterBase<System::Object ^, boost::python::object>
-	{
-		static ToType Convert(System::Object ^value)
-		{
-			if (value == nullptr)
-				throw_null_reference(FriendlyTypename<FromManagedTypeConverter>() + "::Convert(null) not allowed!");
-			FromType fromValue = value;
-			DynamicObjectHandle handle(fromValue);
-			ToType toValue(handle);
-			return toValue;
-		}
-	};
-
-	////////////////////////////////////////////////////////
-	//
-	// SPECIALIZED FROM UNMANAGED TO MANAGED TYPE CONVERTERS
-	//
-
-	// Specialized type converter
-	// C++ string --> managed string
-	template<> struct ToManagedTypeConverter<std::string, System::String ^> : TypeConverterBase<std::string, System::String ^>
-	{
-		static ToType Convert(const FromType &fromValue, System::Type ^resultType)
-		{
-			ToType toValue = ConvertToManagedString(fromValue);
-			return toValue;
-		}
-	};
-
-	// Specialized type converter
-	// python object -> managed object
-	template<> struct ToManagedTypeConverter<boost::python::object, System::Object ^> : TypeConverterBase<boost::python::object, System::Object ^>
-	{
-		static ToType Convert(const FromType &fromValue, System::Type ^resultType)
-		{
-			return ConvertToManagedObject(fromValue, resultType);
-		}
-	};
-
-	template<> struct DynamicObjectDetail::ConversionToManaged::Action<ManagedTypeConversionInfo<System::Object ^, boost::python::object> >
-	{
-		static void Apply(ConversionToManaged &args)
-		{
-			args.result = ToManagedTypeConverter<boost::python::object, System::Object ^>::Convert(args.value, args.resultType);
-		}
-	};
-
-} // namespace InteropPython
-
-#endif//INCLUDED...
+// The MIT License (MIT) Copyright (c) 2016, Susquehanna International Group
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef INCLUDED_PYDOTNET_TYPE_CONVERTER_SPECIALIZATIONS_H
+#define INCLUDED_PYDOTNET_TYPE_CONVERTER_SPECIALIZATIONS_H
+
+#include "DynamicObjectHandle.h"
+
+namespace InteropPython {
+
+	////////////////////////////////////////////////////////
+	//
+	// SPECIALIZED FROM MANAGED TO UNMANAGED TYPE CONVERTERS
+	//
+
+	// Specialized type converter
+	// Managed string --> C++ std::string
+	template<> struct FromManagedTypeConverter<System::String ^, std::string> : TypeConverterBase<System::String ^, std::string>
+	{
+		static ToType Convert(System::Object ^value)
+		{
+			if (value == nullptr)
+				throw_null_reference(FriendlyTypename<FromManagedTypeConverter>() + "::Convert(null) not allowed!");
+			try
+			{
+				FromType fromValue = safe_cast<FromType>(value);
+				ToType toValue = ConvertToUnmanaged(fromValue);
+				return toValue;
+			}
+			catch(System::Exception ^err)
+			{
+				throw_invalid_cast(FriendlyTypename<FromManagedTypeConverter>() + "::Convert(null) failed!\n" + 
+					ConvertToUnmanaged(err->ToString()));
+				throw;
+			}
+		}
+	};
+
+	// Specialized type converter
+	// Managed object --> python object
+	template<> struct FromManagedTypeConverter<System::Object ^, boost::python::object> : TypeConverterBase<System::Object ^, boost::python::object>
+	{
+		static ToType Convert(System::Object ^value)
+		{
+			if (value == nullptr)
+				throw_null_reference(FriendlyTypename<FromManagedTypeConverter>() + "::Convert(null) not allowed!");
+			FromType fromValue = value;
+			if (g_UseIdentityMap)
+			{
+				ToType knownValue = DynamicIdentityMap::Find(fromValue);
+				if (!knownValue.is_none())
+				{
+					return knownValue;
+				}
+			}
+			DynamicObjectHandle handle(fromValue);
+			ToType toValue(handle);
+			if (g_UsePythonTypes)
+			{
+				DynamicPythonTypes::Assign(toValue, fromValue->GetType());
+			}
+			else if (DynamicBuffer::Exports(fromValue->GetType()))
+			{
+				DynamicBuffer::Assign(toValue);
+			}
+			if (HandleScope::IsActive())
+			{
+				// Wrapper released on scope exit must not be found in identity map afterwards
+				boost::python::extract<const ObjectHandle &>(toValue)().AddToScope();
+			}
+			else if (g_UseIdentityMap)
+			{
+				DynamicIdentityMap::Add(fromValue, toValue);
+			}
+			return toValue;
+		}
+	};
+
+	// Specialized type converter
+	// Managed value without python counterpart (char, decimal, enum, etc.) --> python object
+	template<typename FromType_> struct FromManagedTypeConverter<FromType_, boost::python::object> : TypeConverterBase<FromType_, boost::python::object>
+	{
+		static ToType Convert(System::Object ^value)
+		{
+			return FromManagedTypeConverter<System::Object ^, boost::python::object>::Convert(value);
+		}
+	};
+
+	////////////////////////////////////////////////////////
+	//
+	// SPECIALIZED FROM UNMANAGED TO MANAGED TYPE CONVERTERS
+	//
+
+	// Specialized type converter
+	// C++ string --> managed string
+	template<> struct ToManagedTypeConverter<std::string, System::String ^> : TypeConverterBase<std::string, System::String ^>
+	{
+		static ToType Convert(const FromType &fromValue, System::Type ^resultType)
+		{
+			ToType toValue = ConvertToManagedString(fromValue);
+			return toValue;
+		}
+	};
+
+	// Specialized type converter
+	// python object -> managed object
+	template<> struct ToManagedTypeConverter<boost::python::object, System::Object ^> : TypeConverterBase<boost::python::object, System::Object ^>
+	{
+		static ToType Convert(const FromType &fromValue, System::Type ^resultType)
+		{
+			return ConvertToManagedObject(fromValue, resultType);
+		}
+	};
+
+	// Specialized type converter
+	// python str of length 1 --> managed char
+	template<> struct ToManagedTypeConverter<boost::python::object, System::Char> : TypeConverterBase<boost::python::object, System::Char>
+	{
+		static System::Object ^ Convert(const FromType &fromValue, System::Type ^resultType)
+		{
+			boost::python::extract<std::wstring> maybeString(fromValue);
+			if (maybeString.check())
+			{
+				std::wstring s = maybeString;
+				if (s.size() == 1)
+				{
+					return System::Char(s[0]);
+				}
+			}
+			return ConvertToManagedObject(fromValue, resultType);
+		}
+	};
+
+	// Specialized type converter
+	// python int or float --> managed decimal
+	template<> struct ToManagedTypeConverter<boost::python::object, System::Decimal> : TypeConverterBase<boost::python::object, System::Decimal>
+	{
+		static System::Object ^ Convert(const FromType &fromValue, System::Type ^resultType)
+		{
+			boost::python::extract<Int64> maybeLong(fromValue);
+			if (maybeLong.check())
+			{
+				return System::Decimal((Int64)maybeLong);
+			}
+			boost::python::extract<Double> maybeDouble(fromValue);
+			if (maybeDouble.check())
+			{
+				return System::Decimal((Double)maybeDouble);
+			}
+			return ConvertToManagedObject(fromValue, resultType);
+		}
+	};
+
+	// Specialized type converter
+	// python object --> managed date time
+	template<> struct ToManagedTypeConverter<boost::python::object, System::DateTime> : TypeConverterBase<boost::python::object, System::DateTime>
+	{
+		static System::Object ^ Convert(const FromType &fromValue, System::Type ^resultType)
+		{
+			return ConvertToManagedObject(fromValue, resultType);
+		}
+	};
+
+	// Specialized type converter
+	// python int --> managed pointer
+	template<> struct ToManagedTypeConverter<boost::python::object, System::IntPtr> : TypeConverterBase<boost::python::object, System::IntPtr>
+	{
+		static System::Object ^ Convert(const FromType &fromValue, System::Type ^resultType)
+		{
+			boost::python::extract<Int64> maybeLong(fromValue);
+			if (maybeLong.check())
+			{
+				return System::IntPtr((Int64)maybeLong);
+			}
+			return ConvertToManagedObject(fromValue, resultType);
+		}
+	};
+
+	// Specialized type converter
+	// python int --> managed enum of any underlying type
+	template<> struct ToManagedTypeConverter<boost::python::object, System::Enum ^> : TypeConverterBase<boost::python::object, System::Enum ^>
+	{
+		static System::Object ^ Convert(const FromType &fromValue, System::Type ^resultType)
+		{
+			boost::python::extract<Int64> maybeLong(fromValue);
+			if (maybeLong.check() && !boost::python::extract<const DynamicObjectHandle &>(fromValue).check())
+			{
+				return System::Enum::ToObject(resultType, (Int64)maybeLong);
+			}
+			return ConvertToManagedObject(fromValue, resultType);
+		}
+	};
+
+	// Specialized type converter
+	// None or python value --> managed nullable
+	template<> struct ToManagedTypeConverter<boost::python::object, System::ValueType ^> : TypeConverterBase<boost::python::object, System::ValueType ^>
+	{
+		static System::Object ^ Convert(const FromType &fromValue, System::Type ^resultType)
+		{
+			if (fromValue.is_none())
+			{
+				return nullptr;
+			}
+			return DynamicObjectDetail::ConvertToManaged(fromValue, System::Nullable::GetUnderlyingType(resultType));
+		}
+	};
+
+	template<> struct DynamicObjectDetail::ConversionToManaged::Action<ManagedTypeConversionInfo<System::Object ^, boost::python::object> >
+	{
+		static void Apply(ConversionToManaged &args)
+		{
+			args.result = ToManagedTypeConverter<boost::python::object, System::Object ^>::Convert(args.value, args.resultType);
+		}
+	};
+
+	// Strings are transcoded directly between python and managed storage, without intermediate std::string
+	template<> struct DynamicObjectDetail::ConversionToManaged::Action<ManagedTypeConversionInfo<System::String ^, std::string> >
+	{
+		static void Apply(ConversionToManaged &args)
+		{
+			if (args.value.is_none())
+			{
+				args.result = nullptr;
+				return;
+			}
+			System::String ^result = ConvertToManagedString(args.value);
+			if (result == nullptr)
+			{
+				throw_invalid_cast();
+				throw std::runtime_error("Invalid cast");
+			}
+			args.result = result;
+		}
+	};
+
+	template<> struct DynamicObjectDetail::ConversionFromManaged::Action<ManagedTypeConversionInfo<System::String ^, std::string> >
+	{
+		static void Apply(ConversionFromManaged &args)
+		{
+			args.result = ConvertToPythonString(safe_cast<System::String ^>(static_cast<System::Object ^>(args.value)));
+		}
+	};
+
+} // namespace InteropPython
+
+#endif//INCLUDED...
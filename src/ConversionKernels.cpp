@@ -0,0 +1,492 @@
+// The MIT License (MIT) Copyright (c) 2016, Susquehanna International Group
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "ConversionKernels.h"
+
+#pragma managed(push)
+#pragma unmanaged
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define PYDOTNET_KERNELS_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define PYDOTNET_TARGET_AVX2
+#else
+#define PYDOTNET_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace InteropPython {
+
+	namespace {
+
+		ConversionKernels::InstructionSet DetectInstructionSet()
+		{
+#if defined(PYDOTNET_KERNELS_X86)
+#if defined(_MSC_VER)
+			int regs[4];
+			__cpuid(regs, 0);
+			const int maxLeaf = regs[0];
+
+			__cpuid(regs, 1);
+			const bool osxsave = (regs[2] & (1 << 27)) != 0;
+			const bool avx = (regs[2] & (1 << 28)) != 0;
+
+			bool avx2 = false;
+			if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 6) == 6)
+			{
+				__cpuidex(regs, 7, 0);
+				avx2 = (regs[1] & (1 << 5)) != 0;
+			}
+			return avx2 ? ConversionKernels::AVX2 : ConversionKernels::SSE2;
+#else
+			__builtin_cpu_init();
+			return __builtin_cpu_supports("avx2") ? ConversionKernels::AVX2 : ConversionKernels::SSE2;
+#endif
+#else
+			return ConversionKernels::Scalar;
+#endif
+		}
+
+		ConversionKernels::InstructionSet sSupported = DetectInstructionSet();
+		ConversionKernels::InstructionSet sInstructionSet = sSupported;
+
+		// True if value survives conversion to type To, truncating towards zero for floating point source
+		template<typename To, typename From>
+		inline bool FitsIn(From value, std::true_type /*integral To*/, std::true_type /*integral From*/)
+		{
+			const To converted = static_cast<To>(value);
+			return static_cast<From>(converted) == value && (converted < To()) == (value < From());
+		}
+
+		template<typename To, typename From>
+		inline bool FitsIn(From value, std::true_type /*integral To*/, std::false_type /*floating point From*/)
+		{
+			// NaN fails both comparisons
+			const double truncated = std::trunc(static_cast<double>(value));
+			return truncated >= static_cast<double>(std::numeric_limits<To>::min()) && 
+				truncated < std::ldexp(1.0, std::numeric_limits<To>::digits);
+		}
+
+		template<typename To, typename From>
+		inline bool FitsIn(From /*value*/, std::false_type /*floating point To*/, std::true_type /*integral From*/)
+		{
+			// Precision may be lost, but magnitude always fits
+			return true;
+		}
+
+		template<typename To, typename From>
+		inline bool FitsIn(From value, std::false_type /*floating point To*/, std::false_type /*floating point From*/)
+		{
+			// Infinities and NaN are preserved, finite values must not become infinite
+			return sizeof(To) >= sizeof(From) || !std::isfinite(value) || 
+				std::fabs(value) <= static_cast<From>(std::numeric_limits<To>::max());
+		}
+
+		template<typename To, typename From>
+		inline bool FitsIn(From value)
+		{
+			return FitsIn<To>(value, std::is_integral<To>(), std::is_integral<From>());
+		}
+
+		template<typename To, typename From>
+		struct ScalarKernel
+		{
+			static ConversionKernels::Result Run(To *dst, const From *src, size_t n)
+			{
+				for (size_t i = 0; i != n; ++i)
+				{
+					if (!FitsIn<To>(src[i]))
+					{
+						return ConversionKernels::Overflow;
+					}
+					dst[i] = static_cast<To>(src[i]);
+				}
+				return ConversionKernels::Converted;
+			}
+		};
+
+		// Pairs, which have no vector loop, use scalar loop
+		template<typename To, typename From>
+		struct Kernel : ScalarKernel<To, From>
+		{};
+
+#if defined(PYDOTNET_KERNELS_X86)
+
+		////////////////////////////////////////////
+		//
+		// SSE2 LOOPS
+		//
+
+		size_t Sse2SingleToDouble(double *dst, const float *src, size_t n)
+		{
+			size_t i = 0;
+			for (; i + 4 <= n; i += 4)
+			{
+				const __m128 x = _mm_loadu_ps(src + i);
+				_mm_storeu_pd(dst + i, _mm_cvtps_pd(x));
+				_mm_storeu_pd(dst + i + 2, _mm_cvtps_pd(_mm_movehl_ps(x, x)));
+			}
+			return i;
+		}
+
+		size_t Sse2DoubleToSingle(float *dst, const double *src, size_t n)
+		{
+			const __m128d signMask = _mm_set1_pd(-0.0);
+			const __m128d maxValue = _mm_set1_pd(std::numeric_limits<float>::max());
+			const __m128d infinity = _mm_set1_pd(std::numeric_limits<double>::infinity());
+
+			size_t i = 0;
+			for (; i + 4 <= n; i += 4)
+			{
+				const __m128d a = _mm_loadu_pd(src + i);
+				const __m128d b = _mm_loadu_pd(src + i + 2);
+				const __m128d absA = _mm_andnot_pd(signMask, a);
+				const __m128d absB = _mm_andnot_pd(signMask, b);
+				const __m128d bad = _mm_or_pd(
+					_mm_and_pd(_mm_cmpgt_pd(absA, maxValue), _mm_cmpneq_pd(absA, infinity)),
+					_mm_and_pd(_mm_cmpgt_pd(absB, maxValue), _mm_cmpneq_pd(absB, infinity)));
+				if (_mm_movemask_pd(bad) != 0)
+				{
+					break;
+				}
+				_mm_storeu_ps(dst + i, _mm_movelh_ps(_mm_cvtpd_ps(a), _mm_cvtpd_ps(b)));
+			}
+			return i;
+		}
+
+		size_t Sse2Int32ToDouble(double *dst, const int32_t *src, size_t n)
+		{
+			size_t i = 0;
+			for (; i + 4 <= n; i += 4)
+			{
+				const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+				_mm_storeu_pd(dst + i, _mm_cvtepi32_pd(x));
+				_mm_storeu_pd(dst + i + 2, _mm_cvtepi32_pd(_mm_unpackhi_epi64(x, x)));
+			}
+			return i;
+		}
+
+		size_t Sse2DoubleToInt32(int32_t *dst, const double *src, size_t n)
+		{
+			const __m128d lower = _mm_set1_pd(-2147483649.0);
+			const __m128d upper = _mm_set1_pd(2147483648.0);
+
+			size_t i = 0;
+			for (; i + 4 <= n; i += 4)
+			{
+				const __m128d a = _mm_loadu_pd(src + i);
+				const __m128d b = _mm_loadu_pd(src + i + 2);
+				const __m128d good = _mm_and_pd(
+					_mm_and_pd(_mm_cmpgt_pd(a, lower), _mm_cmplt_pd(a, upper)),
+					_mm_and_pd(_mm_cmpgt_pd(b, lower), _mm_cmplt_pd(b, upper)));
+				if (_mm_movemask_pd(good) != 3)
+				{
+					break;
+				}
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), 
+					_mm_unpacklo_epi64(_mm_cvttpd_epi32(a), _mm_cvttpd_epi32(b)));
+			}
+			return i;
+		}
+
+		size_t Sse2Int32ToInt64(int64_t *dst, const int32_t *src, size_t n)
+		{
+			size_t i = 0;
+			for (; i + 4 <= n; i += 4)
+			{
+				const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+				const __m128i sign = _mm_srai_epi32(x, 31);
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_unpacklo_epi32(x, sign));
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i + 2), _mm_unpackhi_epi32(x, sign));
+			}
+			return i;
+		}
+
+		size_t Sse2Int64ToInt32(int32_t *dst, const int64_t *src, size_t n)
+		{
+			size_t i = 0;
+			for (; i + 4 <= n; i += 4)
+			{
+				const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+				const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + 2));
+				const __m128i lo = _mm_unpacklo_epi64(
+					_mm_shuffle_epi32(a, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_epi32(b, _MM_SHUFFLE(2, 0, 2, 0)));
+				const __m128i hi = _mm_unpacklo_epi64(
+					_mm_shuffle_epi32(a, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_epi32(b, _MM_SHUFFLE(3, 1, 3, 1)));
+				// Value fits if its high half is just sign extension of its low half
+				if (_mm_movemask_epi8(_mm_cmpeq_epi32(hi, _mm_srai_epi32(lo, 31))) != 0xFFFF)
+				{
+					break;
+				}
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), lo);
+			}
+			return i;
+		}
+
+		////////////////////////////////////////////
+		//
+		// AVX2 LOOPS
+		//
+
+		PYDOTNET_TARGET_AVX2 size_t Avx2SingleToDouble(double *dst, const float *src, size_t n)
+		{
+			size_t i = 0;
+			for (; i + 8 <= n; i += 8)
+			{
+				_mm256_storeu_pd(dst + i, _mm256_cvtps_pd(_mm_loadu_ps(src + i)));
+				_mm256_storeu_pd(dst + i + 4, _mm256_cvtps_pd(_mm_loadu_ps(src + i + 4)));
+			}
+			return i;
+		}
+
+		PYDOTNET_TARGET_AVX2 size_t Avx2DoubleToSingle(float *dst, const double *src, size_t n)
+		{
+			const __m256d signMask = _mm256_set1_pd(-0.0);
+			const __m256d maxValue = _mm256_set1_pd(std::numeric_limits<float>::max());
+			const __m256d infinity = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+
+			size_t i = 0;
+			for (; i + 4 <= n; i += 4)
+			{
+				const __m256d x = _mm256_loadu_pd(src + i);
+				const __m256d absX = _mm256_andnot_pd(signMask, x);
+				const __m256d bad = _mm256_and_pd(
+					_mm256_cmp_pd(absX, maxValue, _CMP_GT_OQ), _mm256_cmp_pd(absX, infinity, _CMP_NEQ_OQ));
+				if (_mm256_movemask_pd(bad) != 0)
+				{
+					break;
+				}
+				_mm_storeu_ps(dst + i, _mm256_cvtpd_ps(x));
+			}
+			return i;
+		}
+
+		PYDOTNET_TARGET_AVX2 size_t Avx2Int32ToDouble(double *dst, const int32_t *src, size_t n)
+		{
+			size_t i = 0;
+			for (; i + 4 <= n; i += 4)
+			{
+				const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+				_mm256_storeu_pd(dst + i, _mm256_cvtepi32_pd(x));
+			}
+			return i;
+		}
+
+		PYDOTNET_TARGET_AVX2 size_t Avx2DoubleToInt32(int32_t *dst, const double *src, size_t n)
+		{
+			const __m256d lower = _mm256_set1_pd(-2147483649.0);
+			const __m256d upper = _mm256_set1_pd(2147483648.0);
+
+			size_t i = 0;
+			for (; i + 4 <= n; i += 4)
+			{
+				const __m256d x = _mm256_loadu_pd(src + i);
+				const __m256d good = _mm256_and_pd(
+					_mm256_cmp_pd(x, lower, _CMP_GT_OQ), _mm256_cmp_pd(x, upper, _CMP_LT_OQ));
+				if (_mm256_movemask_pd(good) != 0xF)
+				{
+					break;
+				}
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm256_cvttpd_epi32(x));
+			}
+			return i;
+		}
+
+		PYDOTNET_TARGET_AVX2 size_t Avx2Int32ToInt64(int64_t *dst, const int32_t *src, size_t n)
+		{
+			size_t i = 0;
+			for (; i + 8 <= n; i += 8)
+			{
+				const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+				const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + 4));
+				_mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_cvtepi32_epi64(a));
+				_mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i + 4), _mm256_cvtepi32_epi64(b));
+			}
+			return i;
+		}
+
+		PYDOTNET_TARGET_AVX2 size_t Avx2Int64ToInt32(int32_t *dst, const int64_t *src, size_t n)
+		{
+			const __m256i lowHalves = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+
+			size_t i = 0;
+			for (; i + 4 <= n; i += 4)
+			{
+				const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+				const __m128i lo = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(x, lowHalves));
+				// Value fits if sign extending its low half gives it back
+				if (_mm256_movemask_epi8(_mm256_cmpeq_epi64(_mm256_cvtepi32_epi64(lo), x)) != -1)
+				{
+					break;
+				}
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), lo);
+			}
+			return i;
+		}
+
+		// Vector loop converts as many items as it can, and leaves remainder, 
+		// or block with item out of range, to scalar loop.
+#define PYDOTNET_VECTOR_KERNEL(TO, FROM, SSE2_LOOP, AVX2_LOOP) \
+		template<> struct Kernel<TO, FROM> \
+		{ \
+			static ConversionKernels::Result Run(TO *dst, const FROM *src, size_t n) \
+			{ \
+				size_t done = 0; \
+				if (sInstructionSet == ConversionKernels::AVX2) \
+					done = AVX2_LOOP(dst, src, n); \
+				else if (sInstructionSet == ConversionKernels::SSE2) \
+					done = SSE2_LOOP(dst, src, n); \
+				return ScalarKernel<TO, FROM>::Run(dst + done, src + done, n - done); \
+			} \
+		};
+
+		PYDOTNET_VECTOR_KERNEL(double, float, Sse2SingleToDouble, Avx2SingleToDouble)
+		PYDOTNET_VECTOR_KERNEL(float, double, Sse2DoubleToSingle, Avx2DoubleToSingle)
+		PYDOTNET_VECTOR_KERNEL(double, int32_t, Sse2Int32ToDouble, Avx2Int32ToDouble)
+		PYDOTNET_VECTOR_KERNEL(int32_t, double, Sse2DoubleToInt32, Avx2DoubleToInt32)
+		PYDOTNET_VECTOR_KERNEL(int64_t, int32_t, Sse2Int32ToInt64, Avx2Int32ToInt64)
+		PYDOTNET_VECTOR_KERNEL(int32_t, int64_t, Sse2Int64ToInt32, Avx2Int64ToInt32)
+
+#undef PYDOTNET_VECTOR_KERNEL
+
+#endif // PYDOTNET_KERNELS_X86
+
+		template<typename To>
+		ConversionKernels::Result ConvertTo(To *dst, const void *src, ConversionKernels::ItemKind srcKind, size_t begin, size_t n)
+		{
+			switch (srcKind)
+			{
+			case ConversionKernels::Int8: return Kernel<To, int8_t>::Run(dst, static_cast<const int8_t *>(src) + begin, n);
+			case ConversionKernels::UInt8: return Kernel<To, uint8_t>::Run(dst, static_cast<const uint8_t *>(src) + begin, n);
+			case ConversionKernels::Int16: return Kernel<To, int16_t>::Run(dst, static_cast<const int16_t *>(src) + begin, n);
+			case ConversionKernels::UInt16: return Kernel<To, uint16_t>::Run(dst, static_cast<const uint16_t *>(src) + begin, n);
+			case ConversionKernels::Int32: return Kernel<To, int32_t>::Run(dst, static_cast<const int32_t *>(src) + begin, n);
+			case ConversionKernels::UInt32: return Kernel<To, uint32_t>::Run(dst, static_cast<const uint32_t *>(src) + begin, n);
+			case ConversionKernels::Int64: return Kernel<To, int64_t>::Run(dst, static_cast<const int64_t *>(src) + begin, n);
+			case ConversionKernels::UInt64: return Kernel<To, uint64_t>::Run(dst, static_cast<const uint64_t *>(src) + begin, n);
+			case ConversionKernels::Single: return Kernel<To, float>::Run(dst, static_cast<const float *>(src) + begin, n);
+			case ConversionKernels::Double: return Kernel<To, double>::Run(dst, static_cast<const double *>(src) + begin, n);
+			default: return ConversionKernels::Unsupported;
+			}
+		}
+	}
+
+	ConversionKernels::ItemKind ConversionKernels::GetItemKind(const char *format, size_t itemSize)
+	{
+		// No format means plain bytes
+		char code = 'B';
+		if (format != nullptr)
+		{
+			if (*format == '@' || *format == '=' || *format == '<')
+			{
+				++format;
+			}
+			if (format[0] == '\0' || format[1] != '\0')
+			{
+				return Unknown;
+			}
+			code = *format;
+		}
+
+		switch (code)
+		{
+		case 'b': case 'h': case 'i': case 'l': case 'q': case 'n':
+			switch (itemSize)
+			{
+			case 1: return Int8;
+			case 2: return Int16;
+			case 4: return Int32;
+			case 8: return Int64;
+			default: return Unknown;
+			}
+		case 'B': case 'H': case 'I': case 'L': case 'Q': case 'N': case 'c':
+			switch (itemSize)
+			{
+			case 1: return UInt8;
+			case 2: return UInt16;
+			case 4: return UInt32;
+			case 8: return UInt64;
+			default: return Unknown;
+			}
+		case 'f': case 'd':
+			switch (itemSize)
+			{
+			case 4: return Single;
+			case 8: return Double;
+			default: return Unknown;
+			}
+		default:
+			return Unknown;
+		}
+	}
+
+	size_t ConversionKernels::GetItemSize(ItemKind kind)
+	{
+		switch (kind)
+		{
+		case Int8: case UInt8: return 1;
+		case Int16: case UInt16: return 2;
+		case Int32: case UInt32: case Single: return 4;
+		case Int64: case UInt64: case Double: return 8;
+		default: return 0;
+		}
+	}
+
+	ConversionKernels::Result ConversionKernels::Convert(void *dst, ItemKind dstKind, const void *src, ItemKind srcKind, size_t begin, size_t end)
+	{
+		const size_t n = end - begin;
+
+		switch (dstKind)
+		{
+		case Int8: return ConvertTo(static_cast<int8_t *>(dst) + begin, src, srcKind, begin, n);
+		case UInt8: return ConvertTo(static_cast<uint8_t *>(dst) + begin, src, srcKind, begin, n);
+		case Int16: return ConvertTo(static_cast<int16_t *>(dst) + begin, src, srcKind, begin, n);
+		case UInt16: return ConvertTo(static_cast<uint16_t *>(dst) + begin, src, srcKind, begin, n);
+		case Int32: return ConvertTo(static_cast<int32_t *>(dst) + begin, src, srcKind, begin, n);
+		case UInt32: return ConvertTo(static_cast<uint32_t *>(dst) + begin, src, srcKind, begin, n);
+		case Int64: return ConvertTo(static_cast<int64_t *>(dst) + begin, src, srcKind, begin, n);
+		case UInt64: return ConvertTo(static_cast<uint64_t *>(dst) + begin, src, srcKind, begin, n);
+		case Single: return ConvertTo(static_cast<float *>(dst) + begin, src, srcKind, begin, n);
+		case Double: return ConvertTo(static_cast<double *>(dst) + begin, src, srcKind, begin, n);
+		default: return Unsupported;
+		}
+	}
+
+	ConversionKernels::InstructionSet ConversionKernels::GetInstructionSet()
+	{
+		return sInstructionSet;
+	}
+
+	void ConversionKernels::SetInstructionSet(InstructionSet instructionSet)
+	{
+		sInstructionSet = instructionSet < sSupported ? instructionSet : sSupported;
+	}
+
+} // namespace InteropPython
+
+#pragma managed(pop)
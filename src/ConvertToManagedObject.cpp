@@ -1,736 +1,899 @@
-// The MIT License (MIT) Copyright (c) 2016, Susquehanna International Group
-// 
-// Permission is hereby granted, free of charge, to any person obtaining a copy of
-// this software and associated documentation files (the "Software"), to deal in
-// the Software without restriction, including without limitation the rights to
-// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
-// of the Software, and to permit persons to whom the Software is furnished to do
-// so, subject to the following conditions:
-// 
-// The above copyright notice and this permission notice shall be included in all
-// copies or substantial portions of the Software.
-// 
-// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
-// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
-// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
-// SOFTWARE.
-
-#include "InteropPython.h"
-
-namespace InteropPython {
-
-	ref class ActionProxy
-	{
-	public:
-		void Invoke()
-		{
-			AcquireGIL lk;
-			boost::python::object obj(boost::python::borrowed(_obj));
-			obj();
-		}
-
-		generic<class A1> void Invoke(A1 a1)
-		{
-			AcquireGIL lk;
-			boost::python::object obj(boost::python::borrowed(_obj));
-			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
-			obj(x1);
-		}
-
-		generic<class A1, class A2> void Invoke(A1 a1, A2 a2)
-		{
-			AcquireGIL lk;
-			boost::python::object obj(boost::python::borrowed(_obj));
-			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
-			boost::python::object x2 = DynamicObjectDetail::ConvertToPython(a2);
-			obj(x1, x2);
-		}
-
-		generic<class A1, class A2, class A3> void Invoke(A1 a1, A2 a2, A3 a3)
-		{
-			AcquireGIL lk;
-			boost::python::object obj(boost::python::borrowed(_obj));
-			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
-			boost::python::object x2 = DynamicObjectDetail::ConvertToPython(a2);
-			boost::python::object x3 = DynamicObjectDetail::ConvertToPython(a3);
-			obj(x1, x2, x3);
-		}
-
-		generic<class A1, class A2, class A3, class A4> void Invoke(A1 a1, A2 a2, A3 a3, A4 a4)
-		{
-			AcquireGIL lk;
-			boost::python::object obj(boost::python::borrowed(_obj));
-			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
-			boost::python::object x2 = DynamicObjectDetail::ConvertToPython(a2);
-			boost::python::object x3 = DynamicObjectDetail::ConvertToPython(a3);
-			boost::python::object x4 = DynamicObjectDetail::ConvertToPython(a4);
-			obj(x1, x2, x3, x4);
-		}
-
-		generic<class A1, class A2, class A3, class A4, class A5> void Invoke(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5)
-		{
-			AcquireGIL lk;
-			boost::python::object obj(boost::python::borrowed(_obj));
-			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
-			boost::python::object x2 = DynamicObjectDetail::ConvertToPython(a2);
-			boost::python::object x3 = DynamicObjectDetail::ConvertToPython(a3);
-			boost::python::object x4 = DynamicObjectDetail::ConvertToPython(a4);
-			boost::python::object x5 = DynamicObjectDetail::ConvertToPython(a5);
-			obj(x1, x2, x3, x4, x5);
-		}
-
-		generic<class A1, class A2, class A3, class A4, class A5, class A6> void Invoke(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6)
-		{
-			AcquireGIL lk;
-			boost::python::object obj(boost::python::borrowed(_obj));
-			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
-			boost::python::object x2 = DynamicObjectDetail::ConvertToPython(a2);
-			boost::python::object x3 = DynamicObjectDetail::ConvertToPython(a3);
-			boost::python::object x4 = DynamicObjectDetail::ConvertToPython(a4);
-			boost::python::object x5 = DynamicObjectDetail::ConvertToPython(a5);
-			boost::python::object x6 = DynamicObjectDetail::ConvertToPython(a6);
-			obj(x1, x2, x3, x4, x5, x6);
-		}
-
-		generic<class A1, class A2, class A3, class A4, class A5, class A6, class A7> void Invoke(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7)
-		{
-			AcquireGIL lk;
-			boost::python::object obj(boost::python::borrowed(_obj));
-			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
-			boost::python::object x2 = DynamicObjectDetail::ConvertToPython(a2);
-			boost::python::object x3 = DynamicObjectDetail::ConvertToPython(a3);
-			boost::python::object x4 = DynamicObjectDetail::ConvertToPython(a4);
-			boost::python::object x5 = DynamicObjectDetail::ConvertToPython(a5);
-			boost::python::object x6 = DynamicObjectDetail::ConvertToPython(a6);
-			boost::python::object x7 = DynamicObjectDetail::ConvertToPython(a7);
-			obj(x1, x2, x3, x4, x5, x6, x7);
-		}
-
-		generic<class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8> void Invoke(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8)
-		{
-			AcquireGIL lk;
-			boost::python::object obj(boost::python::borrowed(_obj));
-			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
-			boost::python::object x2 = DynamicObjectDetail::ConvertToPython(a2);
-			boost::python::object x3 = DynamicObjectDetail::ConvertToPython(a3);
-			boost::python::object x4 = DynamicObjectDetail::ConvertToPython(a4);
-			boost::python::object x5 = DynamicObjectDetail::ConvertToPython(a5);
-			boost::python::object x6 = DynamicObjectDetail::ConvertToPython(a6);
-			boost::python::object x7 = DynamicObjectDetail::ConvertToPython(a7);
-			boost::python::object x8 = DynamicObjectDetail::ConvertToPython(a8);
-			obj(x1, x2, x3, x4, x5, x6, x7, x8);
-		}
-
-		generic<class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8, class A9> void Invoke(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9)
-		{
-			AcquireGIL lk;
-			boost::python::object obj(boost::python::borrowed(_obj));
-			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
-			boost::python::object x2 = DynamicObjectDetail::ConvertToPython(a2);
-			boost::python::object x3 = DynamicObjectDetail::ConvertToPython(a3);
-			boost::python::object x4 = DynamicObjectDetail::ConvertToPython(a4);
-			boost::python::object x5 = DynamicObjectDetail::ConvertToPython(a5);
-			boost::python::object x6 = DynamicObjectDetail::ConvertToPython(a6);
-			boost::python::object x7 = DynamicObjectDetail::ConvertToPython(a7);
-			boost::python::object x8 = DynamicObjectDetail::ConvertToPython(a8);
-			boost::python::object x9 = DynamicObjectDetail::ConvertToPython(a9);
-			obj(x1, x2, x3, x4, x5, x6, x7, x8, x9);
-		}
-
-		generic<class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8, class A9, class A10> void Invoke(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9, A10 a10)
-		{
-			AcquireGIL lk;
-			boost::python::object obj(boost::python::borrowed(_obj));
-			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
-			boost::python::object x2 = DynamicObjectDetail::ConvertToPython(a2);
-			boost::python::object x3 = DynamicObjectDetail::ConvertToPython(a3);
-			boost::python::object x4 = DynamicObjectDetail::ConvertToPython(a4);
-			boost::python::object x5 = DynamicObjectDetail::ConvertToPython(a5);
-			boost::python::object x6 = DynamicObjectDetail::ConvertToPython(a6);
-			boost::python::object x7 = DynamicObjectDetail::ConvertToPython(a7);
-			boost::python::object x8 = DynamicObjectDetail::ConvertToPython(a8);
-			boost::python::object x9 = DynamicObjectDetail::ConvertToPython(a9);
-			boost::python::object x10 = DynamicObjectDetail::ConvertToPython(a10);
-			obj(x1, x2, x3, x4, x5, x6, x7, x8, x9, x10);
-		}
-
-		ActionProxy(boost::python::object obj)
-		{
-			_obj = obj.ptr();
-			Py_XINCREF(_obj);
-		}
-
-		~ActionProxy()
-		{
-			Py_XDECREF(_obj);
-		}
-
-		PyObject *_obj;
-	};
-
-	ref class FuncProxy
-	{
-	public:
-
-		generic<class R> R Invoke()
-		{
-			AcquireGIL lk;
-			boost::python::object obj(boost::python::borrowed(_obj));
-			boost::python::object rv = obj();
-			return GetReturnValue<R>(rv);
-		}
-
-		generic<class A1, class R> R Invoke(A1 a1)
-		{
-			AcquireGIL lk;
-			boost::python::object obj(boost::python::borrowed(_obj));
-			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
-			boost::python::object rv = obj(x1);
-			return GetReturnValue<R>(rv);
-		}
-
-		generic<class A1, class A2, class R> R Invoke(A1 a1, A2 a2)
-		{
-			AcquireGIL lk;
-			boost::python::object obj(boost::python::borrowed(_obj));
-			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
-			boost::python::object x2 = DynamicObjectDetail::ConvertToPython(a2);
-			boost::python::object rv = obj(x1, x2);
-			return GetReturnValue<R>(rv);
-		}
-
-		generic<class A1, class A2, class A3, class R> R Invoke(A1 a1, A2 a2, A3 a3)
-		{
-			AcquireGIL lk;
-			boost::python::object obj(boost::python::borrowed(_obj));
-			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
-			boost::python::object x2 = DynamicObjectDetail::ConvertToPython(a2);
-			boost::python::object x3 = DynamicObjectDetail::ConvertToPython(a3);
-			boost::python::object rv = obj(x1, x2, x3);
-			return GetReturnValue<R>(rv);
-		}
-
-		generic<class A1, class A2, class A3, class A4, class R> R Invoke(A1 a1, A2 a2, A3 a3, A4 a4)
-		{
-			AcquireGIL lk;
-			boost::python::object obj(boost::python::borrowed(_obj));
-			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
-			boost::python::object x2 = DynamicObjectDetail::ConvertToPython(a2);
-			boost::python::object x3 = DynamicObjectDetail::ConvertToPython(a3);
-			boost::python::object x4 = DynamicObjectDetail::ConvertToPython(a4);
-			boost::python::object rv = obj(x1, x2, x3, x4);
-			return GetReturnValue<R>(rv);
-		}
-
-		generic<class A1, class A2, class A3, class A4, class A5, class R> R Invoke(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5)
-		{
-			AcquireGIL lk;
-			boost::python::object obj(boost::python::borrowed(_obj));
-			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
-			boost::python::object x2 = DynamicObjectDetail::ConvertToPython(a2);
-			boost::python::object x3 = DynamicObjectDetail::ConvertToPython(a3);
-			boost::python::object x4 = DynamicObjectDetail::ConvertToPython(a4);
-			boost::python::object x5 = DynamicObjectDetail::ConvertToPython(a5);
-			boost::python::object rv = obj(x1, x2, x3, x4, x5);
-			return GetReturnValue<R>(rv);
-		}
-
-		generic<class A1, class A2, class A3, class A4, class A5, class A6, class R> R Invoke(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6)
-		{
-			AcquireGIL lk;
-			boost::python::object obj(boost::python::borrowed(_obj));
-			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
-			boost::python::object x2 = DynamicObjectDetail::ConvertToPython(a2);
-			boost::python::object x3 = DynamicObjectDetail::ConvertToPython(a3);
-			boost::python::object x4 = DynamicObjectDetail::ConvertToPython(a4);
-			boost::python::object x5 = DynamicObjectDetail::ConvertToPython(a5);
-			boost::python::object x6 = DynamicObjectDetail::ConvertToPython(a6);
-			boost::python::object rv = obj(x1, x2, x3, x4, x5, x6);
-			return GetReturnValue<R>(rv);
-		}
-
-		generic<class A1, class A2, class A3, class A4, class A5, class A6, class A7, class R> R Invoke(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7)
-		{
-			AcquireGIL lk;
-			boost::python::object obj(boost::python::borrowed(_obj));
-			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
-			boost::python::object x2 = DynamicObjectDetail::ConvertToPython(a2);
-			boost::python::object x3 = DynamicObjectDetail::ConvertToPython(a3);
-			boost::python::object x4 = DynamicObjectDetail::ConvertToPython(a4);
-			boost::python::object x5 = DynamicObjectDetail::ConvertToPython(a5);
-			boost::python::object x6 = DynamicObjectDetail::ConvertToPython(a6);
-			boost::python::object x7 = DynamicObjectDetail::ConvertToPython(a7);
-			boost::python::object rv = obj(x1, x2, x3, x4, x5, x6, x7);
-			return GetReturnValue<R>(rv);
-		}
-
-		generic<class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8, class R> R Invoke(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8)
-		{
-			AcquireGIL lk;
-			boost::python::object obj(boost::python::borrowed(_obj));
-			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
-			boost::python::object x2 = DynamicObjectDetail::ConvertToPython(a2);
-			boost::python::object x3 = DynamicObjectDetail::ConvertToPython(a3);
-			boost::python::object x4 = DynamicObjectDetail::ConvertToPython(a4);
-			boost::python::object x5 = DynamicObjectDetail::ConvertToPython(a5);
-			boost::python::object x6 = DynamicObjectDetail::ConvertToPython(a6);
-			boost::python::object x7 = DynamicObjectDetail::ConvertToPython(a7);
-			boost::python::object x8 = DynamicObjectDetail::ConvertToPython(a8);
-			boost::python::object rv = obj(x1, x2, x3, x4, x5, x6, x7, x8);
-			return GetReturnValue<R>(rv);
-		}
-
-		generic<class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8, class A9, class R> R Invoke(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9)
-		{
-			AcquireGIL lk;
-			boost::python::object obj(boost::python::borrowed(_obj));
-			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
-			boost::python::object x2 = DynamicObjectDetail::ConvertToPython(a2);
-			boost::python::object x3 = DynamicObjectDetail::ConvertToPython(a3);
-			boost::python::object x4 = DynamicObjectDetail::ConvertToPython(a4);
-			boost::python::object x5 = DynamicObjectDetail::ConvertToPython(a5);
-			boost::python::object x6 = DynamicObjectDetail::ConvertToPython(a6);
-			boost::python::object x7 = DynamicObjectDetail::ConvertToPython(a7);
-			boost::python::object x8 = DynamicObjectDetail::ConvertToPython(a8);
-			boost::python::object x9 = DynamicObjectDetail::ConvertToPython(a9);
-			boost::python::object rv = obj(x1, x2, x3, x4, x5, x6, x7, x8, x9);
-			return GetReturnValue<R>(rv);
-		}
-
-		generic<class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8, class A9, class A10, class R> R Invoke(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9, A10 a10)
-		{
-			AcquireGIL lk;
-			boost::python::object obj(boost::python::borrowed(_obj));
-			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
-			boost::python::object x2 = DynamicObjectDetail::ConvertToPython(a2);
-			boost::python::object x3 = DynamicObjectDetail::ConvertToPython(a3);
-			boost::python::object x4 = DynamicObjectDetail::ConvertToPython(a4);
-			boost::python::object x5 = DynamicObjectDetail::ConvertToPython(a5);
-			boost::python::object x6 = DynamicObjectDetail::ConvertToPython(a6);
-			boost::python::object x7 = DynamicObjectDetail::ConvertToPython(a7);
-			boost::python::object x8 = DynamicObjectDetail::ConvertToPython(a8);
-			boost::python::object x9 = DynamicObjectDetail::ConvertToPython(a9);
-			boost::python::object x10 = DynamicObjectDetail::ConvertToPython(a10);
-			boost::python::object rv = obj(x1, x2, x3, x4, x5, x6, x7, x8, x9, x10);
-			return GetReturnValue<R>(rv);
-		}
-
-		generic<class R> R GetReturnValue(boost::python::object val)
-		{
-			System::Object ^obj = DynamicObjectDetail::ConvertToManaged(val, _returnType);
-			return safe_cast<R>(obj);
-		}
-
-		FuncProxy(boost::python::object obj, System::Type ^returnType) : _returnType(returnType)
-		{
-			_obj = obj.ptr();
-			Py_XINCREF(_obj);
-		}
-
-		~FuncProxy()
-		{
-			Py_XDECREF(_obj);
-		}
-
-		PyObject *_obj;
-		System::Type ^_returnType;
-	};
-
-	System::Object ^ ConvertToManagedObject(const boost::python::object &fromValue, System::Type ^resultType)
-	{
-		PYDOTNET_DYNAMICMETHOD_PRINT_WITH_ARGS_DEBUG("Converting to managed object", fromValue);
-
-		if (fromValue.is_none()) 
-		{
-			// TODO: Currently not working, since None causes Boost.Python to think that we pass less parameters than expected.
-			PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Type conversion to nullptr");
-			return nullptr;
-		}
-
-		boost::python::extract<const DynamicObjectHandle &> maybeHandle(fromValue);
-		if (!maybeHandle.check() && PyObject_HasAttrString(fromValue.ptr(), "__object__"))
-      {
-         boost::python::object obj = fromValue.attr("__object__");
-		   maybeHandle = boost::python::extract<const DynamicObjectHandle &>(obj);
-      }
-		if (maybeHandle.check())
-		{
-			const DynamicObjectHandle &handle = maybeHandle;
-
-			auto toValue = handle.GetObject();
-			if (toValue == nullptr)
-			{
-				toValue = handle.GetTypeObject();
-			}
-
-			if (resultType->IsAssignableFrom(toValue->GetType()))
-			{
-				PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("No type conversion required");
-				return toValue;
-			}
-
-			PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Type conversion unsupported");
-		}
-
-		if (resultType->IsAssignableFrom(System::Object::typeid))
-		{
-			PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Converting to System::Object");
-
-			boost::python::extract<int> maybeLong(fromValue);
-			if (maybeLong.check())
-			{
-				PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Converting to System::Int32");
-				long lv = maybeLong;
-				return (Int32)lv;
-			}
-
-			boost::python::extract<double> maybeDouble(fromValue);
-			if (maybeDouble.check())
-			{
-				PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Converting to System::Double");
-				double lv = maybeDouble;
-				return (Double)lv;
-			}
-
-			boost::python::extract<std::string> maybeString(fromValue);
-			if (maybeString.check())
-			{
-				PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Converting to System::String");
-				return ConvertToManagedString(maybeString);
-			}
-
-			PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Type conversion unsupported");
-		}
-
-		if (System::Delegate::typeid->IsAssignableFrom(resultType))
-		{
-			PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Converting to callback...");
-			boost::python::extract<const DynamicMethodInvoker &> maybeMethod(fromValue);
-			if (maybeMethod.check())
-			{
-				PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Using extracted method...");
-				const DynamicMethodInvoker &method = maybeMethod;
-				System::Delegate ^del = method.GetDelegate();
-				return del;
-			}
-			else if (resultType->Name->StartsWith("Action"))
-			{
-				PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Building action proxy...");
-
-				auto methods = ActionProxy::typeid->GetMethods();
-				array<System::Type ^> ^argTypes = resultType->GetGenericArguments();
-				
-				System::Reflection::MethodInfo ^mi;
-
-				if (!resultType->IsGenericType)
-				{
-					PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Building parameter-less action proxy...");
-
-					for (int i = 0; i != methods->Length; ++i)
-					{
-						mi = methods[i];
-
-						if (!mi->Name->Equals("Invoke"))
-						{
-							continue;
-						}
-
-						if (mi->GetParameters()->Length != 0)
-						{
-							continue;
-						}
-
-						ActionProxy ^proxy = gcnew ActionProxy(fromValue);
-						System::Delegate ^del = System::Delegate::CreateDelegate(resultType, proxy, mi);
-						return del;
-					}
-				}
-
-				PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Building action proxy w/ parameters...");
-
-				for (int i = 0; i != methods->Length; ++i)
-				{
-					mi = methods[i];
-
-					if (!mi->Name->Equals("Invoke"))
-					{
-						continue;
-					}
-
-					if (mi->GetGenericArguments()->Length != argTypes->Length)
-					{
-						continue;
-					}
-
-					mi = mi->MakeGenericMethod(argTypes);
-					ActionProxy ^proxy = gcnew ActionProxy(fromValue);
-					System::Delegate ^del = System::Delegate::CreateDelegate(resultType, proxy, mi);
-					return del;
-				}
-			}
-			else if (resultType->Name->StartsWith("Func"))
-			{
-				PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Building func proxy...");
-
-				auto methods = FuncProxy::typeid->GetMethods();
-				array<System::Type ^> ^argTypes = resultType->GetGenericArguments();
-
-				System::Reflection::MethodInfo ^mi;
-
-				for (int i = 0; i != methods->Length; ++i)
-				{
-					mi = methods[i];
-
-					if (!mi->Name->Equals("Invoke"))
-					{
-						continue;
-					}
-
-					if (mi->GetGenericArguments()->Length != argTypes->Length)
-					{
-						continue;
-					}
-
-					mi = mi->MakeGenericMethod(argTypes);
-					FuncProxy ^proxy = gcnew FuncProxy(fromValue, mi->ReturnType);
-					System::Delegate ^del = System::Delegate::CreateDelegate(resultType, proxy, mi);
-					return del;
-				}
-			}
-			else
-			{
-				PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Trying arbitrary delegate...");
-
-				System::Reflection::MethodInfo ^mi0 = resultType->GetMethod("Invoke");
-				array<System::Reflection::ParameterInfo ^> ^parameters = mi0->GetParameters();
-
-				if (mi0->ReturnType->Equals(System::Void::typeid))
-				{
-					PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Building action proxy...");
-
-					auto methods = ActionProxy::typeid->GetMethods();
-					System::Reflection::MethodInfo ^mi;
-
-					if (parameters->Length == 0)
-					{
-						PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Building parameter-less action proxy...");
-
-						for (int i = 0; i != methods->Length; ++i)
-						{
-							mi = methods[i];
-
-							if (!mi->Name->Equals("Invoke"))
-							{
-								continue;
-							}
-
-							if (mi->GetParameters()->Length != 0)
-							{
-								continue;
-							}
-
-							ActionProxy ^proxy = gcnew ActionProxy(fromValue);
-							System::Delegate ^del = System::Delegate::CreateDelegate(resultType, proxy, mi);
-							return del;
-						}
-					}
-
-					PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Building action proxy w/ parameters...");
-
-					array<System::Type ^> ^argTypes = gcnew array<System::Type ^>(parameters->Length);
-
-					for (int i = 0; i != parameters->Length; ++i)
-					{
-						argTypes[i] = parameters[i]->ParameterType;
-					}
-
-					for (int i = 0; i != methods->Length; ++i)
-					{
-						mi = methods[i];
-
-						if (!mi->Name->Equals("Invoke"))
-						{
-							continue;
-						}
-
-						if (mi->GetGenericArguments()->Length != argTypes->Length)
-						{
-							continue;
-						}
-
-						mi = mi->MakeGenericMethod(argTypes);
-						ActionProxy ^proxy = gcnew ActionProxy(fromValue);
-						System::Delegate ^del = System::Delegate::CreateDelegate(resultType, proxy, mi);
-						return del;
-					}
-				}
-				else
-				{
-					PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Building func proxy...");
-
-					auto methods = FuncProxy::typeid->GetMethods();
-					System::Reflection::MethodInfo ^mi;
-
-					array<System::Type ^> ^argTypes = gcnew array<System::Type ^>(parameters->Length + 1);
-
-					for (int i = 0; i != parameters->Length; ++i)
-					{
-						argTypes[i] = parameters[i]->ParameterType;
-					}
-
-					argTypes[argTypes->Length - 1] = mi0->ReturnType;
-
-					for (int i = 0; i != methods->Length; ++i)
-					{
-						mi = methods[i];
-
-						if (!mi->Name->Equals("Invoke"))
-						{
-							continue;
-						}
-
-						if (mi->GetGenericArguments()->Length != argTypes->Length)
-						{
-							continue;
-						}
-
-						mi = mi->MakeGenericMethod(argTypes);
-						FuncProxy ^proxy = gcnew FuncProxy(fromValue, mi->ReturnType);
-						System::Delegate ^del = System::Delegate::CreateDelegate(resultType, proxy, mi);
-						return del;
-					}
-				}
-			}
-		}
-
-		boost::python::extract<boost::python::list> maybeList(fromValue);
-		if (maybeList.check())
-		{
-			PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Converting list...");
-
-			if (resultType->IsArray)
-			{
-				const int n = boost::python::len(fromValue);
-
-				auto elementType = resultType->GetElementType();
-				auto arrayDim = gcnew array<int>(1);
-				arrayDim[0] = n;
-				System::Array ^result = System::Array::CreateInstance(elementType, arrayDim);
-
-				for (int i = 0; i != n; ++i)
-				{
-					boost::python::object item = fromValue[i];
-
-					PYDOTNET_DYNAMICMETHOD_PRINT_WITH_ARGS_DEBUG("Converting item", item);
-					System::Object ^value = DynamicObjectDetail::ConvertToManaged(item, elementType);
-
-					PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Setting item...");
-					result->SetValue(value, i);
-				}
-
-				return result;
-			}
-			else if (resultType->IsGenericType)
-			{
-				array<System::Type ^> ^genericArgs = resultType->GetGenericArguments();
-				if (genericArgs->Length == 1)
-				{
-					if (resultType->IsInterface)
-					{
-						PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Target is an interface, using List implementation...");
-						resultType = List<System::Object ^>::typeid->
-							GetGenericTypeDefinition()->MakeGenericType(genericArgs);
-					}
-
-					PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Constructing...")
-						auto ci = resultType->GetConstructor(gcnew array<System::Type ^>(0));
-					auto instance = ci->Invoke(gcnew array<System::Object ^>(0));
-
-					PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Getting Add method...")
-						auto argTypes = gcnew array<System::Type ^>(1);
-					argTypes[0] = genericArgs[0];
-					auto mi = resultType->GetMethod("Add", argTypes);
-
-					const int n = boost::python::len(fromValue);
-					auto args = gcnew array<System::Object ^>(1);
-
-					for (int i = 0; i != n; ++i)
-					{
-						boost::python::object item = fromValue[i];
-
-						PYDOTNET_DYNAMICMETHOD_PRINT_WITH_ARGS_DEBUG("Converting item", item);
-						System::Object ^value = DynamicObjectDetail::ConvertToManaged(item, genericArgs[0]);
-
-						PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Adding item...");
-						args[0] = value;
-						mi->Invoke(instance, args);
-					}
-
-					PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Returning result...");
-					return instance;
-				}
-			}
-		}
-
-		boost::python::extract<boost::python::dict> maybeDict(fromValue);
-		if (maybeDict.check())
-		{
-			PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Converting dict...");
-
-			if (resultType->IsGenericType)
-			{
-				array<System::Type ^> ^genericArgs = resultType->GetGenericArguments();
-				if (genericArgs->Length == 2)
-				{
-					if (resultType->IsInterface)
-					{
-						PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Target is an interface, using Dictionary implementation...");
-						resultType = Dictionary<System::Object ^, System::Object ^>::typeid->
-							GetGenericTypeDefinition()->MakeGenericType(genericArgs);
-					}
-
-					PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Constructing...")
-						auto ci = resultType->GetConstructor(gcnew array<System::Type ^>(0));
-					auto instance = ci->Invoke(gcnew array<System::Object ^>(0));
-
-					PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Getting Add method...")
-						auto argTypes = gcnew array<System::Type ^>(2);
-					argTypes[0] = genericArgs[0];
-					argTypes[1] = genericArgs[1];
-					auto mi = resultType->GetMethod("Add", argTypes);
-
-					boost::python::dict d = maybeDict;
-					boost::python::list items = d.items();
-
-					const int n = boost::python::len(items);
-					auto args = gcnew array<System::Object ^>(2);
-
-					for (int i = 0; i != n; ++i)
-					{
-						boost::python::tuple pair = boost::python::extract<boost::python::tuple>(items[i]);
-
-						PYDOTNET_DYNAMICMETHOD_PRINT_WITH_ARGS_DEBUG("Converting item", pair);
-						System::Object ^key = DynamicObjectDetail::ConvertToManaged(pair[0], genericArgs[0]);
-						System::Object ^value = DynamicObjectDetail::ConvertToManaged(pair[1], genericArgs[1]);
-
-						PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Adding item...");
-						args[0] = key;
-						args[1] = value;
-						mi->Invoke(instance, args);
-					}
-
-					PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Returning result...");
-					return instance;
-				}
-			}
-		}
-
-		PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Type conversion unsupported");
-		throw_invalid_cast();
-		throw std::runtime_error("Invalid cast");
-	}
-
-}//namespace InteropPython
+// The MIT License (MIT) Copyright (c) 2016, Susquehanna International Group
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "InteropPython.h"
+
+namespace InteropPython {
+
+	ref class ActionProxy
+	{
+	public:
+		void Invoke()
+		{
+			AcquireGIL lk;
+			boost::python::object obj(boost::python::borrowed(_obj));
+			obj();
+		}
+
+		generic<class A1> void Invoke(A1 a1)
+		{
+			AcquireGIL lk;
+			boost::python::object obj(boost::python::borrowed(_obj));
+			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
+			obj(x1);
+		}
+
+		generic<class A1, class A2> void Invoke(A1 a1, A2 a2)
+		{
+			AcquireGIL lk;
+			boost::python::object obj(boost::python::borrowed(_obj));
+			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
+			boost::python::object x2 = DynamicObjectDetail::ConvertToPython(a2);
+			obj(x1, x2);
+		}
+
+		generic<class A1, class A2, class A3> void Invoke(A1 a1, A2 a2, A3 a3)
+		{
+			AcquireGIL lk;
+			boost::python::object obj(boost::python::borrowed(_obj));
+			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
+			boost::python::object x2 = DynamicObjectDetail::ConvertToPython(a2);
+			boost::python::object x3 = DynamicObjectDetail::ConvertToPython(a3);
+			obj(x1, x2, x3);
+		}
+
+		generic<class A1, class A2, class A3, class A4> void Invoke(A1 a1, A2 a2, A3 a3, A4 a4)
+		{
+			AcquireGIL lk;
+			boost::python::object obj(boost::python::borrowed(_obj));
+			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
+			boost::python::object x2 = DynamicObjectDetail::ConvertToPython(a2);
+			boost::python::object x3 = DynamicObjectDetail::ConvertToPython(a3);
+			boost::python::object x4 = DynamicObjectDetail::ConvertToPython(a4);
+			obj(x1, x2, x3, x4);
+		}
+
+		generic<class A1, class A2, class A3, class A4, class A5> void Invoke(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5)
+		{
+			AcquireGIL lk;
+			boost::python::object obj(boost::python::borrowed(_obj));
+			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
+			boost::python::object x2 = DynamicObjectDetail::ConvertToPython(a2);
+			boost::python::object x3 = DynamicObjectDetail::ConvertToPython(a3);
+			boost::python::object x4 = DynamicObjectDetail::ConvertToPython(a4);
+			boost::python::object x5 = DynamicObjectDetail::ConvertToPython(a5);
+			obj(x1, x2, x3, x4, x5);
+		}
+
+		generic<class A1, class A2, class A3, class A4, class A5, class A6> void Invoke(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6)
+		{
+			AcquireGIL lk;
+			boost::python::object obj(boost::python::borrowed(_obj));
+			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
+			boost::python::object x2 = DynamicObjectDetail::ConvertToPython(a2);
+			boost::python::object x3 = DynamicObjectDetail::ConvertToPython(a3);
+			boost::python::object x4 = DynamicObjectDetail::ConvertToPython(a4);
+			boost::python::object x5 = DynamicObjectDetail::ConvertToPython(a5);
+			boost::python::object x6 = DynamicObjectDetail::ConvertToPython(a6);
+			obj(x1, x2, x3, x4, x5, x6);
+		}
+
+		generic<class A1, class A2, class A3, class A4, class A5, class A6, class A7> void Invoke(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7)
+		{
+			AcquireGIL lk;
+			boost::python::object obj(boost::python::borrowed(_obj));
+			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
+			boost::python::object x2 = DynamicObjectDetail::ConvertToPython(a2);
+			boost::python::object x3 = DynamicObjectDetail::ConvertToPython(a3);
+			boost::python::object x4 = DynamicObjectDetail::ConvertToPython(a4);
+			boost::python::object x5 = DynamicObjectDetail::ConvertToPython(a5);
+			boost::python::object x6 = DynamicObjectDetail::ConvertToPython(a6);
+			boost::python::object x7 = DynamicObjectDetail::ConvertToPython(a7);
+			obj(x1, x2, x3, x4, x5, x6, x7);
+		}
+
+		generic<class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8> void Invoke(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8)
+		{
+			AcquireGIL lk;
+			boost::python::object obj(boost::python::borrowed(_obj));
+			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
+			boost::python::object x2 = DynamicObjectDetail::ConvertToPython(a2);
+			boost::python::object x3 = DynamicObjectDetail::ConvertToPython(a3);
+			boost::python::object x4 = DynamicObjectDetail::ConvertToPython(a4);
+			boost::python::object x5 = DynamicObjectDetail::ConvertToPython(a5);
+			boost::python::object x6 = DynamicObjectDetail::ConvertToPython(a6);
+			boost::python::object x7 = DynamicObjectDetail::ConvertToPython(a7);
+			boost::python::object x8 = DynamicObjectDetail::ConvertToPython(a8);
+			obj(x1, x2, x3, x4, x5, x6, x7, x8);
+		}
+
+		generic<class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8, class A9> void Invoke(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9)
+		{
+			AcquireGIL lk;
+			boost::python::object obj(boost::python::borrowed(_obj));
+			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
+			boost::python::object x2 = DynamicObjectDetail::ConvertToPython(a2);
+			boost::python::object x3 = DynamicObjectDetail::ConvertToPython(a3);
+			boost::python::object x4 = DynamicObjectDetail::ConvertToPython(a4);
+			boost::python::object x5 = DynamicObjectDetail::ConvertToPython(a5);
+			boost::python::object x6 = DynamicObjectDetail::ConvertToPython(a6);
+			boost::python::object x7 = DynamicObjectDetail::ConvertToPython(a7);
+			boost::python::object x8 = DynamicObjectDetail::ConvertToPython(a8);
+			boost::python::object x9 = DynamicObjectDetail::ConvertToPython(a9);
+			obj(x1, x2, x3, x4, x5, x6, x7, x8, x9);
+		}
+
+		generic<class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8, class A9, class A10> void Invoke(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9, A10 a10)
+		{
+			AcquireGIL lk;
+			boost::python::object obj(boost::python::borrowed(_obj));
+			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
+			boost::python::object x2 = DynamicObjectDetail::ConvertToPython(a2);
+			boost::python::object x3 = DynamicObjectDetail::ConvertToPython(a3);
+			boost::python::object x4 = DynamicObjectDetail::ConvertToPython(a4);
+			boost::python::object x5 = DynamicObjectDetail::ConvertToPython(a5);
+			boost::python::object x6 = DynamicObjectDetail::ConvertToPython(a6);
+			boost::python::object x7 = DynamicObjectDetail::ConvertToPython(a7);
+			boost::python::object x8 = DynamicObjectDetail::ConvertToPython(a8);
+			boost::python::object x9 = DynamicObjectDetail::ConvertToPython(a9);
+			boost::python::object x10 = DynamicObjectDetail::ConvertToPython(a10);
+			obj(x1, x2, x3, x4, x5, x6, x7, x8, x9, x10);
+		}
+
+		ActionProxy(boost::python::object obj)
+		{
+			_obj = obj.ptr();
+			DeferredRelease::Hold(_obj);
+		}
+
+		~ActionProxy()
+		{
+			this->!ActionProxy();
+		}
+
+		// Runs on CLR finalizer thread, which does not hold the GIL
+		!ActionProxy()
+		{
+			DeferredRelease::Release(_obj);
+			_obj = nullptr;
+		}
+
+		PyObject *_obj;
+	};
+
+	ref class FuncProxy
+	{
+	public:
+
+		generic<class R> R Invoke()
+		{
+			AcquireGIL lk;
+			boost::python::object obj(boost::python::borrowed(_obj));
+			boost::python::object rv = obj();
+			return GetReturnValue<R>(rv);
+		}
+
+		generic<class A1, class R> R Invoke(A1 a1)
+		{
+			AcquireGIL lk;
+			boost::python::object obj(boost::python::borrowed(_obj));
+			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
+			boost::python::object rv = obj(x1);
+			return GetReturnValue<R>(rv);
+		}
+
+		generic<class A1, class A2, class R> R Invoke(A1 a1, A2 a2)
+		{
+			AcquireGIL lk;
+			boost::python::object obj(boost::python::borrowed(_obj));
+			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
+			boost::python::object x2 = DynamicObjectDetail::ConvertToPython(a2);
+			boost::python::object rv = obj(x1, x2);
+			return GetReturnValue<R>(rv);
+		}
+
+		generic<class A1, class A2, class A3, class R> R Invoke(A1 a1, A2 a2, A3 a3)
+		{
+			AcquireGIL lk;
+			boost::python::object obj(boost::python::borrowed(_obj));
+			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
+			boost::python::object x2 = DynamicObjectDetail::ConvertToPython(a2);
+			boost::python::object x3 = DynamicObjectDetail::ConvertToPython(a3);
+			boost::python::object rv = obj(x1, x2, x3);
+			return GetReturnValue<R>(rv);
+		}
+
+		generic<class A1, class A2, class A3, class A4, class R> R Invoke(A1 a1, A2 a2, A3 a3, A4 a4)
+		{
+			AcquireGIL lk;
+			boost::python::object obj(boost::python::borrowed(_obj));
+			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
+			boost::python::object x2 = DynamicObjectDetail::ConvertToPython(a2);
+			boost::python::object x3 = DynamicObjectDetail::ConvertToPython(a3);
+			boost::python::object x4 = DynamicObjectDetail::ConvertToPython(a4);
+			boost::python::object rv = obj(x1, x2, x3, x4);
+			return GetReturnValue<R>(rv);
+		}
+
+		generic<class A1, class A2, class A3, class A4, class A5, class R> R Invoke(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5)
+		{
+			AcquireGIL lk;
+			boost::python::object obj(boost::python::borrowed(_obj));
+			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
+			boost::python::object x2 = DynamicObjectDetail::ConvertToPython(a2);
+			boost::python::object x3 = DynamicObjectDetail::ConvertToPython(a3);
+			boost::python::object x4 = DynamicObjectDetail::ConvertToPython(a4);
+			boost::python::object x5 = DynamicObjectDetail::ConvertToPython(a5);
+			boost::python::object rv = obj(x1, x2, x3, x4, x5);
+			return GetReturnValue<R>(rv);
+		}
+
+		generic<class A1, class A2, class A3, class A4, class A5, class A6, class R> R Invoke(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6)
+		{
+			AcquireGIL lk;
+			boost::python::object obj(boost::python::borrowed(_obj));
+			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
+			boost::python::object x2 = DynamicObjectDetail::ConvertToPython(a2);
+			boost::python::object x3 = DynamicObjectDetail::ConvertToPython(a3);
+			boost::python::object x4 = DynamicObjectDetail::ConvertToPython(a4);
+			boost::python::object x5 = DynamicObjectDetail::ConvertToPython(a5);
+			boost::python::object x6 = DynamicObjectDetail::ConvertToPython(a6);
+			boost::python::object rv = obj(x1, x2, x3, x4, x5, x6);
+			return GetReturnValue<R>(rv);
+		}
+
+		generic<class A1, class A2, class A3, class A4, class A5, class A6, class A7, class R> R Invoke(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7)
+		{
+			AcquireGIL lk;
+			boost::python::object obj(boost::python::borrowed(_obj));
+			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
+			boost::python::object x2 = DynamicObjectDetail::ConvertToPython(a2);
+			boost::python::object x3 = DynamicObjectDetail::ConvertToPython(a3);
+			boost::python::object x4 = DynamicObjectDetail::ConvertToPython(a4);
+			boost::python::object x5 = DynamicObjectDetail::ConvertToPython(a5);
+			boost::python::object x6 = DynamicObjectDetail::ConvertToPython(a6);
+			boost::python::object x7 = DynamicObjectDetail::ConvertToPython(a7);
+			boost::python::object rv = obj(x1, x2, x3, x4, x5, x6, x7);
+			return GetReturnValue<R>(rv);
+		}
+
+		generic<class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8, class R> R Invoke(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8)
+		{
+			AcquireGIL lk;
+			boost::python::object obj(boost::python::borrowed(_obj));
+			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
+			boost::python::object x2 = DynamicObjectDetail::ConvertToPython(a2);
+			boost::python::object x3 = DynamicObjectDetail::ConvertToPython(a3);
+			boost::python::object x4 = DynamicObjectDetail::ConvertToPython(a4);
+			boost::python::object x5 = DynamicObjectDetail::ConvertToPython(a5);
+			boost::python::object x6 = DynamicObjectDetail::ConvertToPython(a6);
+			boost::python::object x7 = DynamicObjectDetail::ConvertToPython(a7);
+			boost::python::object x8 = DynamicObjectDetail::ConvertToPython(a8);
+			boost::python::object rv = obj(x1, x2, x3, x4, x5, x6, x7, x8);
+			return GetReturnValue<R>(rv);
+		}
+
+		generic<class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8, class A9, class R> R Invoke(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9)
+		{
+			AcquireGIL lk;
+			boost::python::object obj(boost::python::borrowed(_obj));
+			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
+			boost::python::object x2 = DynamicObjectDetail::ConvertToPython(a2);
+			boost::python::object x3 = DynamicObjectDetail::ConvertToPython(a3);
+			boost::python::object x4 = DynamicObjectDetail::ConvertToPython(a4);
+			boost::python::object x5 = DynamicObjectDetail::ConvertToPython(a5);
+			boost::python::object x6 = DynamicObjectDetail::ConvertToPython(a6);
+			boost::python::object x7 = DynamicObjectDetail::ConvertToPython(a7);
+			boost::python::object x8 = DynamicObjectDetail::ConvertToPython(a8);
+			boost::python::object x9 = DynamicObjectDetail::ConvertToPython(a9);
+			boost::python::object rv = obj(x1, x2, x3, x4, x5, x6, x7, x8, x9);
+			return GetReturnValue<R>(rv);
+		}
+
+		generic<class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8, class A9, class A10, class R> R Invoke(A1 a1, A2 a2, A3 a3, A4 a4, A5 a5, A6 a6, A7 a7, A8 a8, A9 a9, A10 a10)
+		{
+			AcquireGIL lk;
+			boost::python::object obj(boost::python::borrowed(_obj));
+			boost::python::object x1 = DynamicObjectDetail::ConvertToPython(a1);
+			boost::python::object x2 = DynamicObjectDetail::ConvertToPython(a2);
+			boost::python::object x3 = DynamicObjectDetail::ConvertToPython(a3);
+			boost::python::object x4 = DynamicObjectDetail::ConvertToPython(a4);
+			boost::python::object x5 = DynamicObjectDetail::ConvertToPython(a5);
+			boost::python::object x6 = DynamicObjectDetail::ConvertToPython(a6);
+			boost::python::object x7 = DynamicObjectDetail::ConvertToPython(a7);
+			boost::python::object x8 = DynamicObjectDetail::ConvertToPython(a8);
+			boost::python::object x9 = DynamicObjectDetail::ConvertToPython(a9);
+			boost::python::object x10 = DynamicObjectDetail::ConvertToPython(a10);
+			boost::python::object rv = obj(x1, x2, x3, x4, x5, x6, x7, x8, x9, x10);
+			return GetReturnValue<R>(rv);
+		}
+
+		generic<class R> R GetReturnValue(boost::python::object val)
+		{
+			System::Object ^obj = DynamicObjectDetail::ConvertToManaged(val, _returnType);
+			return safe_cast<R>(obj);
+		}
+
+		FuncProxy(boost::python::object obj, System::Type ^returnType) : _returnType(returnType)
+		{
+			_obj = obj.ptr();
+			DeferredRelease::Hold(_obj);
+		}
+
+		~FuncProxy()
+		{
+			this->!FuncProxy();
+		}
+
+		// Runs on CLR finalizer thread, which does not hold the GIL
+		!FuncProxy()
+		{
+			DeferredRelease::Release(_obj);
+			_obj = nullptr;
+		}
+
+		PyObject *_obj;
+		System::Type ^_returnType;
+	};
+
+	// Finds Invoke method of ActionProxy or FuncProxy matching signature of delegate type,
+	// and caches it closed over parameter types, so that converting callable into delegate
+	// costs single proxy allocation and single CreateDelegate call.
+	// Used only with __compiledinvokers__ off, as otherwise CompiledInvokers build delegates.
+	ref class ProxyMethods abstract sealed
+	{
+	public:
+		static System::Reflection::MethodInfo ^ GetProxyMethod(System::Type ^delegateType)
+		{
+			System::Reflection::MethodInfo ^mi;
+			if (!_methods->TryGetValue(delegateType, mi))
+			{
+				mi = FindProxyMethod(delegateType);
+				_methods->TryAdd(delegateType, mi);
+			}
+			return mi;
+		}
+
+	private:
+		static ProxyMethods()
+		{
+			_methods = gcnew System::Collections::Concurrent::ConcurrentDictionary<
+				System::Type ^, System::Reflection::MethodInfo ^>();
+		}
+
+		static System::Reflection::MethodInfo ^ FindProxyMethod(System::Type ^delegateType)
+		{
+			System::Reflection::MethodInfo ^signature = delegateType->GetMethod("Invoke");
+			if (signature == nullptr || delegateType->ContainsGenericParameters)
+			{
+				return nullptr;
+			}
+
+			array<System::Reflection::ParameterInfo ^> ^parameters = signature->GetParameters();
+			bool isAction = signature->ReturnType->Equals(System::Void::typeid);
+
+			// Func proxy takes return type as the last generic argument
+			array<System::Type ^> ^argTypes = gcnew array<System::Type ^>(parameters->Length + (isAction ? 0 : 1));
+			for (int i = 0; i != parameters->Length; ++i)
+			{
+				argTypes[i] = parameters[i]->ParameterType;
+			}
+			if (!isAction)
+			{
+				argTypes[argTypes->Length - 1] = signature->ReturnType;
+			}
+
+			array<System::Reflection::MethodInfo ^> ^methods = (isAction ? ActionProxy::typeid : FuncProxy::typeid)->GetMethods();
+			for (int i = 0; i != methods->Length; ++i)
+			{
+				System::Reflection::MethodInfo ^mi = methods[i];
+
+				if (!mi->Name->Equals("Invoke") || mi->GetParameters()->Length != parameters->Length)
+				{
+					continue;
+				}
+
+				if (argTypes->Length == 0)
+				{
+					return mi;
+				}
+
+				if (mi->GetGenericArguments()->Length != argTypes->Length)
+				{
+					continue;
+				}
+
+				try
+				{
+					return mi->MakeGenericMethod(argTypes);
+				}
+				catch (System::ArgumentException ^)
+				{
+					// i.e. ref / out parameters or pointers cannot be generic arguments
+					return nullptr;
+				}
+			}
+
+			return nullptr;
+		}
+
+		static System::Collections::Concurrent::ConcurrentDictionary<
+			System::Type ^, System::Reflection::MethodInfo ^> ^_methods;
+	};
+
+	// Conversion plan of arguments passed to python callable and of values it returns, computed once per delegate type.
+	ref class CallbackPlan
+	{
+	public:
+		static CallbackPlan ^ Get(System::Type ^delegateType)
+		{
+			CallbackPlan ^plan;
+			if (!_plans->TryGetValue(delegateType, plan))
+			{
+				plan = gcnew CallbackPlan(delegateType->GetMethod("Invoke"));
+				_plans->TryAdd(delegateType, plan);
+			}
+			return plan;
+		}
+
+		// Return type, or nullptr if delegate returns void
+		System::Type ^ReturnType;
+
+		// Indices and types of REF and OUT parameters
+		array<int> ^OutputIndices;
+		array<System::Type ^> ^OutputTypes;
+
+		// Converters of arguments into python, one per parameter
+		std::vector<DynamicObjectDetail::ToPythonConverter> *ArgumentConverters;
+
+	private:
+		CallbackPlan(System::Reflection::MethodInfo ^signature)
+		{
+			array<System::Reflection::ParameterInfo ^> ^parameters = signature->GetParameters();
+			System::Collections::Generic::List<int> ^indices = gcnew System::Collections::Generic::List<int>();
+			System::Collections::Generic::List<System::Type ^> ^types = gcnew System::Collections::Generic::List<System::Type ^>();
+			ArgumentConverters = new std::vector<DynamicObjectDetail::ToPythonConverter>(parameters->Length);
+
+			for (int i = 0; i != parameters->Length; ++i)
+			{
+				(*ArgumentConverters)[i] = DynamicObjectDetail::GetToPythonConverter(parameters[i]->ParameterType);
+
+				if (parameters[i]->ParameterType->IsByRef)
+				{
+					indices->Add(i);
+					types->Add(parameters[i]->ParameterType->GetElementType());
+				}
+			}
+
+			ReturnType = signature->ReturnType->Equals(System::Void::typeid) ? nullptr : signature->ReturnType;
+			OutputIndices = indices->ToArray();
+			OutputTypes = types->ToArray();
+		}
+
+		~CallbackPlan()
+		{
+			this->!CallbackPlan();
+		}
+
+		!CallbackPlan()
+		{
+			delete ArgumentConverters;
+			ArgumentConverters = nullptr;
+		}
+
+		static CallbackPlan()
+		{
+			_plans = gcnew System::Collections::Concurrent::ConcurrentDictionary<
+				System::Type ^, CallbackPlan ^>();
+		}
+
+		static System::Collections::Concurrent::ConcurrentDictionary<
+			System::Type ^, CallbackPlan ^> ^_plans;
+	};
+
+	// Target of delegates built by CompiledInvokers::GetCallbackFactory.
+	// When delegate has REF or OUT parameters, python callable returns tuple of 
+	// return value (unless delegate returns void) followed by their new values.
+	ref class CallbackProxy : ICallbackTarget
+	{
+	public:
+		virtual System::Object ^ Invoke(array<System::Object ^> ^args)
+		{
+			AcquireGIL lk;
+			boost::python::object obj(boost::python::borrowed(_obj));
+
+			const std::vector<DynamicObjectDetail::ToPythonConverter> &converters = *_plan->ArgumentConverters;
+
+			boost::python::object pyargs(boost::python::detail::new_reference(PyTuple_New(args->Length)));
+			for (int i = 0; i != args->Length; ++i)
+			{
+				boost::python::object x = converters[i](args[i]);
+				PyTuple_SET_ITEM(pyargs.ptr(), i, boost::python::incref(x.ptr()));
+			}
+
+			boost::python::object rv(boost::python::handle<>(PyObject_CallObject(obj.ptr(), pyargs.ptr())));
+
+			const int outputs = _plan->OutputIndices->Length;
+			if (outputs == 0)
+			{
+				return (_plan->ReturnType != nullptr ? DynamicObjectDetail::ConvertToManaged(rv, _plan->ReturnType) : nullptr);
+			}
+
+			const int count = outputs + (_plan->ReturnType != nullptr ? 1 : 0);
+			boost::python::object values = rv;
+			if (count == 1)
+			{
+				values = boost::python::make_tuple(rv);
+			}
+			else if (!PyTuple_Check(rv.ptr()) || PyTuple_GET_SIZE(rv.ptr()) != count)
+			{
+				throw gcnew System::InvalidCastException(System::String::Format(
+					"Callback must return tuple of {0} values, i.e. return value followed by REF and OUT parameters", count));
+			}
+
+			int next = 0;
+			System::Object ^result = nullptr;
+			if (_plan->ReturnType != nullptr)
+			{
+				result = DynamicObjectDetail::ConvertToManaged(values[next++], _plan->ReturnType);
+			}
+			for (int i = 0; i != outputs; ++i)
+			{
+				args[_plan->OutputIndices[i]] = DynamicObjectDetail::ConvertToManaged(values[next++], _plan->OutputTypes[i]);
+			}
+			return result;
+		}
+
+		CallbackProxy(boost::python::object obj, CallbackPlan ^plan) : _plan(plan)
+		{
+			_obj = obj.ptr();
+			DeferredRelease::Hold(_obj);
+		}
+
+		~CallbackProxy()
+		{
+			this->!CallbackProxy();
+		}
+
+		// Runs on CLR finalizer thread, which does not hold the GIL
+		!CallbackProxy()
+		{
+			DeferredRelease::Release(_obj);
+			_obj = nullptr;
+		}
+
+		PyObject *_obj;
+		CallbackPlan ^_plan;
+	};
+
+	System::Object ^ ConvertToManagedObject(const boost::python::object &fromValue, System::Type ^resultType)
+	{
+		PYDOTNET_DYNAMICMETHOD_PRINT_WITH_ARGS_DEBUG("Converting to managed object", fromValue);
+
+		if (fromValue.is_none()) 
+		{
+			// TODO: Currently not working, since None causes Boost.Python to think that we pass less parameters than expected.
+			PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Type conversion to nullptr");
+			return nullptr;
+		}
+
+		boost::python::extract<const DynamicView &> maybeView(fromValue);
+		if (maybeView.check())
+		{
+			const DynamicView &view = maybeView;
+			System::Object ^result = view.CreateView(resultType);
+			if (result != nullptr)
+			{
+				PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Passing lazy view");
+				return result;
+			}
+
+			PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("No view for target type, copying...");
+			return ConvertToManagedObject(view.GetObject(), resultType);
+		}
+
+		boost::python::extract<const DynamicObjectHandle &> maybeHandle(fromValue);
+		if (!maybeHandle.check() && PyObject_HasAttrString(fromValue.ptr(), "__object__"))
+      {
+         boost::python::object obj = fromValue.attr("__object__");
+		   maybeHandle = boost::python::extract<const DynamicObjectHandle &>(obj);
+      }
+		if (maybeHandle.check())
+		{
+			const DynamicObjectHandle &handle = maybeHandle;
+
+			auto toValue = handle.GetObject();
+			if (toValue == nullptr)
+			{
+				toValue = handle.GetTypeObject();
+			}
+
+			if (resultType->IsAssignableFrom(toValue->GetType()))
+			{
+				PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("No type conversion required");
+				return toValue;
+			}
+
+			PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Type conversion unsupported");
+		}
+
+		if (resultType->IsAssignableFrom(System::Object::typeid))
+		{
+			PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Converting to System::Object");
+
+			boost::python::extract<int> maybeLong(fromValue);
+			if (maybeLong.check())
+			{
+				PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Converting to System::Int32");
+				long lv = maybeLong;
+				return (Int32)lv;
+			}
+
+			boost::python::extract<double> maybeDouble(fromValue);
+			if (maybeDouble.check())
+			{
+				PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Converting to System::Double");
+				double lv = maybeDouble;
+				return (Double)lv;
+			}
+
+			System::String ^maybeString = ConvertToManagedString(fromValue);
+			if (maybeString != nullptr)
+			{
+				PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Converting to System::String");
+				return maybeString;
+			}
+
+			PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Type conversion unsupported");
+		}
+
+		if (System::Delegate::typeid->IsAssignableFrom(resultType))
+		{
+			PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Converting to callback...");
+			boost::python::extract<const DynamicMethodInvoker &> maybeMethod(fromValue);
+			if (maybeMethod.check())
+			{
+				PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Using extracted method...");
+				const DynamicMethodInvoker &method = maybeMethod;
+				System::Delegate ^del = method.GetDelegate();
+				return del;
+			}
+
+			CompiledCallbackFactory ^factory = g_UseCompiledInvokers ? CompiledInvokers::GetCallbackFactory(resultType) : nullptr;
+			if (factory != nullptr)
+			{
+				PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Building compiled callback...");
+				CallbackProxy ^proxy = gcnew CallbackProxy(fromValue, CallbackPlan::Get(resultType));
+				return factory(proxy);
+			}
+
+			System::Reflection::MethodInfo ^mi = ProxyMethods::GetProxyMethod(resultType);
+			if (mi != nullptr)
+			{
+				if (mi->DeclaringType->Equals(FuncProxy::typeid))
+				{
+					PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Building func proxy...");
+					FuncProxy ^proxy = gcnew FuncProxy(fromValue, mi->ReturnType);
+					return System::Delegate::CreateDelegate(resultType, proxy, mi);
+				}
+				else
+				{
+					PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Building action proxy...");
+					ActionProxy ^proxy = gcnew ActionProxy(fromValue);
+					return System::Delegate::CreateDelegate(resultType, proxy, mi);
+				}
+			}
+
+			PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("No proxy matches delegate signature");
+		}
+
+		if (g_UseCompiledInvokers && resultType->IsGenericType && resultType->GetGenericArguments()->Length == 1)
+		{
+			array<System::Type ^> ^genericArgs = resultType->GetGenericArguments();
+			System::Type ^arrayType = genericArgs[0]->MakeArrayType();
+
+			if (boost::python::extract<boost::python::list>(fromValue).check() || DynamicBuffer::CanConvert(fromValue, arrayType))
+			{
+				System::Type ^collectionType = resultType->IsInterface 
+					? List<System::Object ^>::typeid->GetGenericTypeDefinition()->MakeGenericType(genericArgs)
+					: resultType;
+
+				CompiledCollectionBuilder ^builder = CompiledInvokers::GetCollectionBuilder(collectionType);
+				if (builder != nullptr && resultType->IsAssignableFrom(collectionType))
+				{
+					PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Converting sequence into array, and building collection from it...");
+					System::Array ^items = safe_cast<System::Array ^>(ConvertToManagedObject(fromValue, arrayType));
+					return builder(items);
+				}
+			}
+		}
+
+		if (DynamicBuffer::CanConvert(fromValue, resultType))
+		{
+			PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Converting buffer...");
+
+			System::Array ^result = DynamicBuffer::ToManagedArray(fromValue, resultType);
+			if (result != nullptr)
+			{
+				return result;
+			}
+
+			PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Buffer not contiguous or of unsupported format, converting item by item...");
+			return ConvertToManagedObject(boost::python::list(fromValue), resultType);
+		}
+
+		if (resultType->IsGenericType && resultType->GetGenericArguments()->Length == 1 && 
+			DynamicBuffer::CanConvert(fromValue, resultType->GetGenericArguments()[0]->MakeArrayType()))
+		{
+			PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Converting buffer into collection item by item...");
+			return ConvertToManagedObject(boost::python::list(fromValue), resultType);
+		}
+
+		boost::python::extract<boost::python::list> maybeList(fromValue);
+		if (maybeList.check())
+		{
+			PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Converting list...");
+
+			if (resultType->IsArray)
+			{
+				auto elementType = resultType->GetElementType();
+
+				System::Array ^typed = DynamicObjectDetail::ConvertListToManagedArray(maybeList(), elementType);
+				if (typed != nullptr)
+				{
+					PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Converted list into typed array...");
+					return typed;
+				}
+
+				const int n = boost::python::len(fromValue);
+
+				auto arrayDim = gcnew array<int>(1);
+				arrayDim[0] = n;
+				System::Array ^result = System::Array::CreateInstance(elementType, arrayDim);
+
+				for (int i = 0; i != n; ++i)
+				{
+					boost::python::object item = fromValue[i];
+
+					PYDOTNET_DYNAMICMETHOD_PRINT_WITH_ARGS_DEBUG("Converting item", item);
+					System::Object ^value = DynamicObjectDetail::ConvertToManaged(item, elementType);
+
+					PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Setting item...");
+					result->SetValue(value, i);
+				}
+
+				return result;
+			}
+			else if (resultType->IsGenericType)
+			{
+				array<System::Type ^> ^genericArgs = resultType->GetGenericArguments();
+				if (genericArgs->Length == 1)
+				{
+					if (resultType->IsInterface)
+					{
+						PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Target is an interface, using List implementation...");
+						resultType = List<System::Object ^>::typeid->
+							GetGenericTypeDefinition()->MakeGenericType(genericArgs);
+					}
+
+					PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Constructing...")
+						auto ci = resultType->GetConstructor(gcnew array<System::Type ^>(0));
+					auto instance = ci->Invoke(gcnew array<System::Object ^>(0));
+
+					PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Getting Add method...")
+						auto argTypes = gcnew array<System::Type ^>(1);
+					argTypes[0] = genericArgs[0];
+					auto mi = resultType->GetMethod("Add", argTypes);
+
+					const int n = boost::python::len(fromValue);
+					auto args = gcnew array<System::Object ^>(1);
+
+					for (int i = 0; i != n; ++i)
+					{
+						boost::python::object item = fromValue[i];
+
+						PYDOTNET_DYNAMICMETHOD_PRINT_WITH_ARGS_DEBUG("Converting item", item);
+						System::Object ^value = DynamicObjectDetail::ConvertToManaged(item, genericArgs[0]);
+
+						PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Adding item...");
+						args[0] = value;
+						mi->Invoke(instance, args);
+					}
+
+					PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Returning result...");
+					return instance;
+				}
+			}
+		}
+
+		boost::python::extract<boost::python::dict> maybeDict(fromValue);
+		if (maybeDict.check())
+		{
+			PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Converting dict...");
+
+			if (resultType->IsGenericType)
+			{
+				array<System::Type ^> ^genericArgs = resultType->GetGenericArguments();
+				if (genericArgs->Length == 2)
+				{
+					if (resultType->IsInterface)
+					{
+						PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Target is an interface, using Dictionary implementation...");
+						resultType = Dictionary<System::Object ^, System::Object ^>::typeid->
+							GetGenericTypeDefinition()->MakeGenericType(genericArgs);
+					}
+
+					CompiledDictionaryBuilder ^builder = g_UseCompiledInvokers ? CompiledInvokers::GetDictionaryBuilder(resultType) : nullptr;
+					if (builder != nullptr)
+					{
+						PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Converting keys and values into arrays, and building dictionary from them...");
+
+						// Keys and values of unmodified dict are listed in the same order
+						boost::python::list pyKeys(boost::python::handle<>(PyDict_Keys(fromValue.ptr())));
+						boost::python::list pyValues(boost::python::handle<>(PyDict_Values(fromValue.ptr())));
+
+						System::Array ^keys = safe_cast<System::Array ^>(ConvertToManagedObject(pyKeys, genericArgs[0]->MakeArrayType()));
+						System::Array ^values = safe_cast<System::Array ^>(ConvertToManagedObject(pyValues, genericArgs[1]->MakeArrayType()));
+
+						return builder(keys, values);
+					}
+
+					PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Constructing...")
+						auto ci = resultType->GetConstructor(gcnew array<System::Type ^>(0));
+					auto instance = ci->Invoke(gcnew array<System::Object ^>(0));
+
+					PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Getting Add method...")
+						auto argTypes = gcnew array<System::Type ^>(2);
+					argTypes[0] = genericArgs[0];
+					argTypes[1] = genericArgs[1];
+					auto mi = resultType->GetMethod("Add", argTypes);
+
+					boost::python::dict d = maybeDict;
+					boost::python::list items = d.items();
+
+					const int n = boost::python::len(items);
+					auto args = gcnew array<System::Object ^>(2);
+
+					for (int i = 0; i != n; ++i)
+					{
+						boost::python::tuple pair = boost::python::extract<boost::python::tuple>(items[i]);
+
+						PYDOTNET_DYNAMICMETHOD_PRINT_WITH_ARGS_DEBUG("Converting item", pair);
+						System::Object ^key = DynamicObjectDetail::ConvertToManaged(pair[0], genericArgs[0]);
+						System::Object ^value = DynamicObjectDetail::ConvertToManaged(pair[1], genericArgs[1]);
+
+						PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Adding item...");
+						args[0] = key;
+						args[1] = value;
+						mi->Invoke(instance, args);
+					}
+
+					PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Returning result...");
+					return instance;
+				}
+			}
+		}
+
+		PYDOTNET_DYNAMICMETHOD_PRINT_DEBUG("Type conversion unsupported");
+		throw_invalid_cast();
+		throw std::runtime_error("Invalid cast");
+	}
+
+}//namespace InteropPython
@@ -0,0 +1,124 @@
+// The MIT License (MIT) Copyright (c) 2016, Susquehanna International Group
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "InteropPython.h"
+#include <intrin.h>
+
+// Stack is manipulated with interlocked intrinsics, which are only available to native code
+#pragma managed(push, off)
+
+namespace InteropPython {
+
+	DeferredRelease::Node * volatile DeferredRelease::sHead = nullptr;
+	volatile long DeferredRelease::sHeld = 0;
+	volatile long DeferredRelease::sHeldPeak = 0;
+	volatile long DeferredRelease::sPending = 0;
+
+	void DeferredRelease::Hold(PyObject *obj)
+	{
+		Py_XINCREF(obj);
+		Adopt(obj);
+	}
+
+	void DeferredRelease::Adopt(PyObject *obj)
+	{
+		if (obj != nullptr)
+		{
+			long held = _InterlockedIncrement(&sHeld);
+			long peak = sHeldPeak;
+			while (held > peak && _InterlockedCompareExchange(&sHeldPeak, held, peak) != peak)
+			{
+				peak = sHeldPeak;
+			}
+		}
+	}
+
+	void DeferredRelease::Release(PyObject *obj)
+	{
+		if (obj == nullptr)
+		{
+			return;
+		}
+
+		_InterlockedDecrement(&sHeld);
+
+		// References held at interpreter shutdown are abandoned
+		if (!Py_IsInitialized())
+		{
+			return;
+		}
+
+#if PY_VERSION_HEX >= 0x03040000
+		if (PyGILState_Check())
+		{
+			Py_DECREF(obj);
+			return;
+		}
+#endif
+
+		// Push only competes with other pushes, as drain takes whole stack at once, 
+		// so that stack is not exposed to ABA problem.
+		Node *node = new Node;
+		node->obj = obj;
+
+		Node *head;
+		do
+		{
+			head = sHead;
+			node->next = head;
+		}
+		while (_InterlockedCompareExchangePointer((void * volatile *)&sHead, node, head) != head);
+
+		_InterlockedIncrement(&sPending);
+	}
+
+	void DeferredRelease::DrainAll()
+	{
+		Node *node = (Node *)_InterlockedExchangePointer((void * volatile *)&sHead, nullptr);
+
+		while (node != nullptr)
+		{
+			// Releasing object may run python code, which drains references pushed meanwhile
+			Node *next = node->next;
+			_InterlockedDecrement(&sPending);
+			Py_DECREF(node->obj);
+			delete node;
+			node = next;
+		}
+	}
+
+	long DeferredRelease::GetHeldCount()
+	{
+		return sHeld;
+	}
+
+	long DeferredRelease::GetHeldPeakCount()
+	{
+		return sHeldPeak;
+	}
+
+	long DeferredRelease::GetPendingCount()
+	{
+		return sPending;
+	}
+
+}// namespace InteropPython
+
+#pragma managed(pop)
@@ -0,0 +1,449 @@
+// The MIT License (MIT) Copyright (c) 2016, Susquehanna International Group
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "InteropPython.h"
+
+namespace InteropPython {
+
+	namespace {
+
+		// Pinning handle and dimensions of single exported view
+		struct ExportedBuffer
+		{
+			void *pin;
+			std::vector<Py_ssize_t> shape;
+			std::vector<Py_ssize_t> strides;
+		};
+	}
+
+	int DynamicBuffer::sPinned = 0;
+	int DynamicBuffer::sPinnedPeak = 0;
+	PyObject *DynamicBuffer::sArrayClass = nullptr;
+
+	bool DynamicBuffer::Exports(System::Type ^typ)
+	{
+		return sArrayClass != nullptr && typ->IsArray && GetFormat(typ->GetElementType()) != nullptr;
+	}
+
+	boost::python::object DynamicBuffer::GetArrayClass()
+	{
+		return boost::python::object(boost::python::handle<>(boost::python::borrowed(sArrayClass)));
+	}
+
+	void DynamicBuffer::Assign(boost::python::object &obj)
+	{
+		// Plain setattr would end up in Interop.Object.__setattr__, which sets managed properties
+		boost::python::str attr("__class__");
+		if (PyObject_GenericSetAttr(obj.ptr(), attr.ptr(), sArrayClass) != 0)
+		{
+			boost::python::throw_error_already_set();
+		}
+	}
+
+	const char *DynamicBuffer::GetFormat(System::Type ^elementType)
+	{
+		if (elementType->IsEnum)
+		{
+			return nullptr;
+		}
+
+		switch (System::Type::GetTypeCode(elementType))
+		{
+		case System::TypeCode::Byte: return "B";
+		case System::TypeCode::SByte: return "b";
+		case System::TypeCode::UInt16: return "H";
+		case System::TypeCode::Int16: return "h";
+		case System::TypeCode::UInt32: return "I";
+		case System::TypeCode::Int32: return "i";
+		case System::TypeCode::UInt64: return "Q";
+		case System::TypeCode::Int64: return "q";
+		case System::TypeCode::Single: return "f";
+		case System::TypeCode::Double: return "d";
+		default: return nullptr;
+		}
+	}
+
+	int DynamicBuffer::GetItemSize(System::Type ^elementType)
+	{
+		switch (System::Type::GetTypeCode(elementType))
+		{
+		case System::TypeCode::Byte:
+		case System::TypeCode::SByte: return 1;
+		case System::TypeCode::UInt16:
+		case System::TypeCode::Int16: return 2;
+		case System::TypeCode::UInt32:
+		case System::TypeCode::Int32:
+		case System::TypeCode::Single: return 4;
+		case System::TypeCode::UInt64:
+		case System::TypeCode::Int64:
+		case System::TypeCode::Double: return 8;
+		default: return 0;
+		}
+	}
+
+	std::string DynamicBuffer::GetInstructionSet()
+	{
+		switch (ConversionKernels::GetInstructionSet())
+		{
+		case ConversionKernels::SSE2: return "sse2";
+		case ConversionKernels::AVX2: return "avx2";
+		default: return "scalar";
+		}
+	}
+
+	void DynamicBuffer::SetInstructionSet(const std::string &name)
+	{
+		if (name == "scalar")
+		{
+			ConversionKernels::SetInstructionSet(ConversionKernels::Scalar);
+		}
+		else if (name == "sse2")
+		{
+			ConversionKernels::SetInstructionSet(ConversionKernels::SSE2);
+		}
+		else if (name == "avx2")
+		{
+			ConversionKernels::SetInstructionSet(ConversionKernels::AVX2);
+		}
+		else
+		{
+			throw_value_error("Instruction set expected to be one of 'scalar', 'sse2' or 'avx2'");
+			throw std::runtime_error("Unknown instruction set");
+		}
+	}
+
+#if PY_VERSION_HEX >= 0x03000000
+
+	namespace {
+
+		// Copies larger than this are done with GIL released
+		const Py_ssize_t kReleaseGILCopySize = 1 << 20;
+
+		// Conversions of more items than this are split across cores
+		const size_t kParallelConversionCount = 1 << 20;
+
+		// Items converted by single task
+		const size_t kParallelChunkSize = 1 << 18;
+
+		// Releases python buffer on scope exit
+		struct BufferView
+		{
+			Py_buffer view;
+			bool valid;
+
+			BufferView(PyObject *obj, int flags)
+			{
+				valid = (PyObject_GetBuffer(obj, &view, flags) == 0);
+				if (!valid)
+				{
+					PyErr_Clear();
+				}
+			}
+
+			~BufferView()
+			{
+				if (valid)
+				{
+					PyBuffer_Release(&view);
+				}
+			}
+		};
+	}
+
+	// Converts items of python buffer into managed array in chunks spread across thread pool
+	ref class ParallelItemConversion
+	{
+	public:
+		static ConversionKernels::Result Run(void *dst, ConversionKernels::ItemKind dstKind, 
+			const void *src, ConversionKernels::ItemKind srcKind, size_t count)
+		{
+			ParallelItemConversion ^conversion = gcnew ParallelItemConversion(dst, dstKind, src, srcKind, count);
+			const int nChunks = (int)((count + kParallelChunkSize - 1) / kParallelChunkSize);
+			System::Threading::Tasks::Parallel::For(0, nChunks, gcnew System::Action<int>(conversion, &ParallelItemConversion::RunChunk));
+			return (ConversionKernels::Result)conversion->_result;
+		}
+
+	private:
+		ParallelItemConversion(void *dst, ConversionKernels::ItemKind dstKind, 
+			const void *src, ConversionKernels::ItemKind srcKind, size_t count)
+			: _dst(dst), _dstKind(dstKind), _src(src), _srcKind(srcKind), _count(count), _result(ConversionKernels::Converted)
+		{}
+
+		void RunChunk(int chunk)
+		{
+			const size_t begin = (size_t)chunk * kParallelChunkSize;
+			const size_t end = begin + kParallelChunkSize < _count ? begin + kParallelChunkSize : _count;
+			ConversionKernels::Result result = ConversionKernels::Convert(_dst, _dstKind, _src, _srcKind, begin, end);
+			if (result != ConversionKernels::Converted)
+			{
+				_result = result;
+			}
+		}
+
+		void *_dst;
+		ConversionKernels::ItemKind _dstKind;
+		const void *_src;
+		ConversionKernels::ItemKind _srcKind;
+		size_t _count;
+		int _result;
+	};
+
+	bool DynamicBuffer::CanConvert(const boost::python::object &value, System::Type ^arrayType)
+	{
+		return arrayType->IsArray && 
+			PyObject_CheckBuffer(value.ptr()) && 
+			GetFormat(arrayType->GetElementType()) != nullptr;
+	}
+
+	System::Array ^ DynamicBuffer::ToManagedArray(const boost::python::object &value, System::Type ^arrayType)
+	{
+		using namespace System::Runtime::InteropServices;
+
+		if (!CanConvert(value, arrayType))
+		{
+			return nullptr;
+		}
+
+		System::Type ^elementType = arrayType->GetElementType();
+		const ConversionKernels::ItemKind dstKind = ConversionKernels::GetItemKind(GetFormat(elementType), GetItemSize(elementType));
+
+		BufferView buffer(value.ptr(), PyBUF_C_CONTIGUOUS | PyBUF_FORMAT);
+		if (!buffer.valid)
+		{
+			return nullptr;
+		}
+
+		const Py_buffer &view = buffer.view;
+		const ConversionKernels::ItemKind srcKind = ConversionKernels::GetItemKind(view.format, view.itemsize);
+		if (srcKind == ConversionKernels::Unknown)
+		{
+			return nullptr;
+		}
+
+		// Source of other shape is left to item by item conversion, rather than being flattened or reshaped
+		const int rank = arrayType->GetArrayRank();
+		if (view.ndim != rank || view.shape == nullptr)
+		{
+			return nullptr;
+		}
+
+		const size_t count = (size_t)(view.len / view.itemsize);
+		auto lengths = gcnew array<int>(rank);
+		for (int i = 0; i != rank; ++i)
+		{
+			lengths[i] = (int)view.shape[i];
+		}
+
+		System::Array ^result = System::Array::CreateInstance(elementType, lengths);
+		if (count == 0)
+		{
+			return result;
+		}
+
+		ConversionKernels::Result converted = ConversionKernels::Converted;
+		GCHandle pin = GCHandle::Alloc(result, GCHandleType::Pinned);
+		try
+		{
+			void *target = pin.AddrOfPinnedObject().ToPointer();
+			if (srcKind == dstKind)
+			{
+				if (view.len >= kReleaseGILCopySize)
+				{
+					ReleaseGIL lk;
+					memcpy(target, view.buf, view.len);
+				}
+				else
+				{
+					memcpy(target, view.buf, view.len);
+				}
+			}
+			else if (count >= kParallelConversionCount)
+			{
+				ReleaseGIL lk;
+				converted = ParallelItemConversion::Run(target, dstKind, view.buf, srcKind, count);
+			}
+			else
+			{
+				converted = ConversionKernels::Convert(target, dstKind, view.buf, srcKind, 0, count);
+			}
+		}
+		finally
+		{
+			pin.Free();
+		}
+
+		if (converted == ConversionKernels::Overflow)
+		{
+			throw_overflow_error("Buffer item out of range of " + ConvertToUnmanaged(elementType->FullName));
+			throw std::runtime_error("Buffer item out of range");
+		}
+		if (converted != ConversionKernels::Converted)
+		{
+			return nullptr;
+		}
+
+		return result;
+	}
+
+	PyBufferProcs DynamicBuffer::sBufferProcs = { &DynamicBuffer::GetBuffer, &DynamicBuffer::ReleaseBuffer };
+
+	void DynamicBuffer::Register(const std::string &name)
+	{
+		PYDOTNET_REGISTER_PRINT_DEBUG(name);
+
+		PyTypeObject *base = boost::python::converter::registered<DynamicObjectHandle>::converters.get_class_object();
+		boost::python::object baseClass(boost::python::handle<>(boost::python::borrowed((PyObject *)base)));
+		boost::python::object metaClass(boost::python::handle<>(boost::python::borrowed((PyObject *)Py_TYPE(base))));
+
+		boost::python::dict ns;
+		ns["__doc__"] = "Managed array of primitive element type, which supports buffer protocol";
+		boost::python::object cls = metaClass(name, boost::python::make_tuple(baseClass), ns);
+
+		// Types created later as subclasses (i.e. by DynamicPythonTypes) inherit these slots
+		((PyTypeObject *)cls.ptr())->tp_as_buffer = &sBufferProcs;
+
+		boost::python::scope().attr(name.c_str()) = cls;
+		sArrayClass = boost::python::incref(cls.ptr());
+	}
+
+	int DynamicBuffer::GetBuffer(PyObject *exporter, Py_buffer *view, int flags)
+	{
+		using namespace System::Runtime::InteropServices;
+
+		view->obj = nullptr;
+
+		boost::python::object self(boost::python::handle<>(boost::python::borrowed(exporter)));
+		boost::python::extract<const DynamicObjectHandle &> maybeHandle(self);
+		if (!maybeHandle.check())
+		{
+			PyErr_SetString(PyExc_BufferError, "Interop.Object expected");
+			return -1;
+		}
+
+		System::Array ^arr = dynamic_cast<System::Array ^>(maybeHandle().GetObject());
+		if (arr == nullptr)
+		{
+			PyErr_SetString(PyExc_BufferError, "Only managed arrays support buffer protocol");
+			return -1;
+		}
+
+		System::Type ^elementType = arr->GetType()->GetElementType();
+		const char *format = GetFormat(elementType);
+		if (format == nullptr)
+		{
+			PyErr_SetString(PyExc_BufferError, ("Array of " + ConvertToUnmanaged(elementType->FullName) + 
+				" does not support buffer protocol").c_str());
+			return -1;
+		}
+
+		const int itemSize = GetItemSize(elementType);
+		const int ndim = arr->Rank;
+
+		ExportedBuffer *exported = new ExportedBuffer();
+		exported->shape.resize(ndim);
+		exported->strides.resize(ndim);
+
+		// Multi-dimensional managed arrays are laid out in row-major order
+		Py_ssize_t stride = itemSize;
+		for (int i = ndim - 1; i >= 0; --i)
+		{
+			exported->shape[i] = arr->GetLength(i);
+			exported->strides[i] = stride;
+			stride *= exported->shape[i];
+		}
+
+		GCHandle pin;
+		try
+		{
+			pin = GCHandle::Alloc(arr, GCHandleType::Pinned);
+		}
+		catch (System::Exception ^err)
+		{
+			delete exported;
+			PyErr_SetString(PyExc_BufferError, ConvertToUnmanaged(err->Message).c_str());
+			return -1;
+		}
+		exported->pin = GCHandle::ToIntPtr(pin).ToPointer();
+		if (++sPinned > sPinnedPeak)
+		{
+			sPinnedPeak = sPinned;
+		}
+
+		view->buf = pin.AddrOfPinnedObject().ToPointer();
+		view->obj = exporter;
+		view->len = (Py_ssize_t)arr->LongLength * itemSize;
+		view->itemsize = itemSize;
+		view->readonly = 0;
+		view->format = (flags & PyBUF_FORMAT) ? const_cast<char *>(format) : nullptr;
+
+		// Consumer not asking for shape sees array as flat run of bytes, which must have single dimension
+		if ((flags & PyBUF_ND) == PyBUF_ND)
+		{
+			view->ndim = ndim;
+			view->shape = exported->shape.data();
+		}
+		else
+		{
+			view->ndim = 1;
+			view->shape = nullptr;
+		}
+		view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? exported->strides.data() : nullptr;
+		view->suboffsets = nullptr;
+		view->internal = exported;
+
+		Py_INCREF(exporter);
+		return 0;
+	}
+
+	void DynamicBuffer::ReleaseBuffer(PyObject *exporter, Py_buffer *view)
+	{
+		using namespace System::Runtime::InteropServices;
+
+		ExportedBuffer *exported = static_cast<ExportedBuffer *>(view->internal);
+		if (exported != nullptr)
+		{
+			GCHandle::FromIntPtr(System::IntPtr(exported->pin)).Free();
+			--sPinned;
+			delete exported;
+			view->internal = nullptr;
+		}
+	}
+
+#else
+
+	void DynamicBuffer::Register(const std::string &name)
+	{
+		// New buffer protocol is supported by Python 3 only, so that arrays keep plain Interop.Object
+	}
+
+	bool DynamicBuffer::CanConvert(const boost::python::object &value, System::Type ^arrayType)
+	{
+		return false;
+	}
+
+	System::Array ^ DynamicBuffer::ToManagedArray(const boost::python::object &value, System::Type ^arrayType)
+	{
+		return nullptr;
+	}
+
+#endif
+
+}// namespace InteropPython
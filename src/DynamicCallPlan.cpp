@@ -0,0 +1,128 @@
+// The MIT License (MIT) Copyright (c) 2016, Susquehanna International Group
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "InteropPython.h"
+
+namespace InteropPython {
+
+	ref class CallPlanCache abstract sealed
+	{
+	public:
+		static System::Collections::Concurrent::ConcurrentDictionary<
+			System::Reflection::MethodBase ^, System::IntPtr> ^Plans;
+
+	private:
+		static CallPlanCache()
+		{
+			Plans = gcnew System::Collections::Concurrent::ConcurrentDictionary<
+				System::Reflection::MethodBase ^, System::IntPtr>();
+		}
+	};
+
+	CallPlan::CallPlan(System::Reflection::MethodBase ^mb) : _mb(mb), _compiled(false)
+	{
+		array<System::Reflection::ParameterInfo ^> ^pis = mb->GetParameters();
+
+		nParameters = pis->Length;
+		nOutArgs = 0;
+		takesCallbacks = false;
+		keepGIL = false;
+		flags.resize(nParameters);
+
+		array<System::Type ^> ^ptypes = gcnew array<System::Type ^>(nParameters);
+		array<System::Object ^> ^pdefaults = gcnew array<System::Object ^>(nParameters);
+
+		for (int i = 0; i != nParameters; ++i)
+		{
+			System::Reflection::ParameterInfo ^pi = pis[i];
+			ptypes[i] = pi->ParameterType;
+			flags[i] = 0;
+
+			if (System::Delegate::typeid->IsAssignableFrom(ptypes[i]))
+			{
+				takesCallbacks = true;
+			}
+
+			if (pi->IsOut)
+			{
+				flags[i] |= Out;
+				++nOutArgs;
+
+				if (!pi->IsIn)
+				{
+					flags[i] |= NoInput;
+				}
+			}
+
+			if (pi->IsOptional)
+			{
+				flags[i] |= Optional;
+
+				// Optional parameters without default value get Type.Missing when they are of type Object,
+				// as they did when passed through reflection, and default of their type otherwise
+				System::Object ^dv = pi->DefaultValue;
+				if (dv == System::DBNull::Value || dv == System::Type::Missing)
+				{
+					System::Type ^vt = ptypes[i]->IsByRef ? ptypes[i]->GetElementType() : ptypes[i];
+					if (vt->Equals(System::Object::typeid))
+					{
+						dv = System::Type::Missing;
+					}
+					else
+					{
+						dv = vt->IsValueType ? System::Activator::CreateInstance(vt) : nullptr;
+					}
+				}
+				pdefaults[i] = dv;
+			}
+		}
+
+		System::Reflection::MethodInfo ^mi = dynamic_cast<System::Reflection::MethodInfo ^>(mb);
+		isVoid = (mi != nullptr && mi->ReturnType->Equals(System::Void::typeid));
+
+		types = ptypes;
+		defaults = pdefaults;
+		parameters = pis;
+	}
+
+	const CallPlan *CallPlan::Get(System::Reflection::MethodBase ^mb)
+	{
+		System::IntPtr ptr;
+		if (CallPlanCache::Plans->TryGetValue(mb, ptr))
+		{
+			return static_cast<const CallPlan *>(ptr.ToPointer());
+		}
+
+		CallPlan *plan = new CallPlan(mb);
+		if (!CallPlanCache::Plans->TryAdd(mb, System::IntPtr(plan)))
+		{
+			delete plan;
+			return static_cast<const CallPlan *>(CallPlanCache::Plans[mb].ToPointer());
+		}
+		return plan;
+	}
+
+	int CallPlan::GetCount()
+	{
+		return CallPlanCache::Plans->Count;
+	}
+
+}// namespace InteropPython
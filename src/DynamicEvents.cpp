@@ -0,0 +1,426 @@
+// The MIT License (MIT) Copyright (c) 2016, Susquehanna International Group
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "InteropPython.h"
+
+namespace InteropPython {
+
+	EventRing::EventRing(int capacity) : _enqueuePos(0), _dequeuePos(0), _dropped(0), _closed(false)
+	{
+		if (capacity < 1)
+		{
+			throw gcnew System::ArgumentOutOfRangeException("capacity");
+		}
+
+		// Capacity is rounded up to power of two, so that slot is found by masking position
+		int size = 1;
+		while (size < capacity)
+		{
+			size <<= 1;
+		}
+
+		_mask = size - 1;
+		_sequences = gcnew array<System::Int64>(size);
+		_targets = gcnew array<System::Object ^>(size);
+		_args = gcnew array<array<System::Object ^> ^>(size);
+		_signal = gcnew System::Threading::ManualResetEventSlim(false);
+
+		for (int i = 0; i != size; ++i)
+		{
+			_sequences[i] = i;
+		}
+	}
+
+	bool EventRing::TryEnqueue(System::Object ^target, array<System::Object ^> ^args)
+	{
+		if (_closed)
+		{
+			return false;
+		}
+
+		System::Int64 pos = System::Threading::Interlocked::Read(_enqueuePos);
+		for (;;)
+		{
+			int slot = (int)(pos & _mask);
+			System::Int64 diff = System::Threading::Thread::VolatileRead(_sequences[slot]) - pos;
+
+			if (diff == 0)
+			{
+				// Slot is free, and becomes ours once we advance enqueue position past it
+				System::Int64 seen = System::Threading::Interlocked::CompareExchange(_enqueuePos, pos + 1, pos);
+				if (seen == pos)
+				{
+					_targets[slot] = target;
+					_args[slot] = args;
+					System::Threading::Thread::VolatileWrite(_sequences[slot], pos + 1);
+					break;
+				}
+				pos = seen;
+			}
+			else if (diff < 0)
+			{
+				// Slot still holds invocation from previous lap, which was not dispatched yet
+				System::Threading::Interlocked::Increment(_dropped);
+				return false;
+			}
+			else
+			{
+				pos = System::Threading::Interlocked::Read(_enqueuePos);
+			}
+		}
+
+		if (!_signal->IsSet)
+		{
+			_signal->Set();
+		}
+		return true;
+	}
+
+	bool EventRing::TryDequeue(System::Object ^%target, array<System::Object ^> ^%args)
+	{
+		System::Int64 pos = _dequeuePos;
+		int slot = (int)(pos & _mask);
+
+		if (System::Threading::Thread::VolatileRead(_sequences[slot]) != pos + 1)
+		{
+			return false;
+		}
+
+		target = _targets[slot];
+		args = _args[slot];
+		_targets[slot] = nullptr;
+		_args[slot] = nullptr;
+
+		// Slot is released for enqueue at the same position of the next lap
+		System::Threading::Thread::VolatileWrite(_sequences[slot], pos + _mask + 1);
+		System::Threading::Interlocked::Exchange(_dequeuePos, pos + 1);
+		return true;
+	}
+
+	bool EventRing::Wait(int millisecondsTimeout)
+	{
+		if (Pending > 0 || _closed)
+		{
+			return (Pending > 0);
+		}
+
+		// Reset before checking again, so that invocation enqueued meanwhile is not missed
+		_signal->Reset();
+		if (Pending == 0 && !_closed)
+		{
+			_signal->Wait(millisecondsTimeout);
+		}
+		return (Pending > 0);
+	}
+
+	void EventRing::Close()
+	{
+		_closed = true;
+		_signal->Set();
+	}
+
+	// Delegates added to events from python, so that the same python handler can be removed later.
+	// Subscriptions are kept per event source, and released together with it.
+	// Handlers are matched by equality, as e.g. each access to self.on_changed creates new bound method.
+	ref class EventSubscriptions abstract sealed
+	{
+	public:
+		ref struct Subscription
+		{
+			Subscription(System::Reflection::EventInfo ^ei, PyObject *handler) : Event(ei), Handler(handler)
+			{
+				DeferredRelease::Hold(Handler);
+			}
+
+			~Subscription()
+			{
+				this->!Subscription();
+			}
+
+			// Runs on CLR finalizer thread, which does not hold the GIL
+			!Subscription()
+			{
+				DeferredRelease::Release(Handler);
+				Handler = nullptr;
+			}
+
+			System::Reflection::EventInfo ^Event;
+			PyObject *Handler;
+			EventRing ^Ring;
+			System::Delegate ^Delegate;
+		};
+
+		static void Add(System::Object ^source, Subscription ^subscription)
+		{
+			_subscriptions->GetOrCreateValue(source)->Add(subscription);
+		}
+
+		// Removes and returns most recently added matching subscription, or nullptr if there is none.
+		// Must be called with the GIL held, as handlers are compared by python equality.
+		static System::Delegate ^ Remove(System::Object ^source, System::Reflection::EventInfo ^ei, PyObject *handler, EventRing ^ring)
+		{
+			System::Collections::Generic::List<Subscription ^> ^list;
+			if (!_subscriptions->TryGetValue(source, list))
+			{
+				return nullptr;
+			}
+
+			for (int i = list->Count - 1; i >= 0; --i)
+			{
+				Subscription ^s = list[i];
+				if (!s->Event->Equals(ei) || s->Ring != ring)
+				{
+					continue;
+				}
+
+				int equal = PyObject_RichCompareBool(s->Handler, handler, Py_EQ);
+				if (equal < 0)
+				{
+					boost::python::throw_error_already_set();
+				}
+				if (equal)
+				{
+					list->RemoveAt(i);
+					System::Delegate ^del = s->Delegate;
+					delete s;
+					return del;
+				}
+			}
+			return nullptr;
+		}
+
+		// Static events are kept under their EventInfo
+		static System::Object ^ GetSource(System::Object ^obj, System::Reflection::EventInfo ^ei)
+		{
+			return (obj != nullptr ? obj : safe_cast<System::Object ^>(ei));
+		}
+
+	private:
+		static EventSubscriptions()
+		{
+			_subscriptions = gcnew System::Runtime::CompilerServices::ConditionalWeakTable<
+				System::Object ^, System::Collections::Generic::List<Subscription ^> ^>();
+		}
+
+		static System::Runtime::CompilerServices::ConditionalWeakTable<
+			System::Object ^, System::Collections::Generic::List<Subscription ^> ^> ^_subscriptions;
+	};
+
+	System::Delegate ^DynamicQueuedHandler::CreateDelegate(System::Type ^handlerType) const
+	{
+		// Queued invocation cannot produce return value, nor values of REF and OUT parameters
+		System::Reflection::MethodInfo ^signature = handlerType->GetMethod("Invoke");
+		if (signature == nullptr || !signature->ReturnType->Equals(System::Void::typeid))
+		{
+			return nullptr;
+		}
+
+		array<System::Reflection::ParameterInfo ^> ^parameters = signature->GetParameters();
+		for (int i = 0; i != parameters->Length; ++i)
+		{
+			if (parameters[i]->ParameterType->IsByRef)
+			{
+				return nullptr;
+			}
+		}
+
+		CompiledCallbackFactory ^factory = CompiledInvokers::GetCallbackFactory(handlerType);
+		if (factory == nullptr)
+		{
+			return nullptr;
+		}
+
+		return factory(gcnew QueuedEventTarget(_ring, _handler.ptr()));
+	}
+
+	void DynamicQueuedHandler::Register(const std::string &name)
+	{
+		using namespace boost::python;
+
+		PYDOTNET_REGISTER_PRINT_DEBUG(name);
+
+		class_<DynamicQueuedHandler>(name.c_str(), no_init)
+			.add_property("Handler", &DynamicQueuedHandler::GetHandler, "Python callable invoked on dispatch")
+			;
+	}
+
+	int DynamicEventQueue::Dispatch(int maxCount)
+	{
+		EventRing ^ring = _ring;
+
+		// Invocations enqueued while dispatching are left for next dispatch
+		System::Int64 limit = ring->Pending;
+		if (maxCount > 0 && maxCount < limit)
+		{
+			limit = maxCount;
+		}
+
+		int count = 0;
+		System::Object ^target;
+		array<System::Object ^> ^args;
+
+		while (count < limit && ring->TryDequeue(target, args))
+		{
+			++count;
+
+			QueuedEventTarget ^queued = safe_cast<QueuedEventTarget ^>(target);
+			if (queued->GetHandler() == nullptr)
+			{
+				continue;
+			}
+
+			boost::python::object pyargs(boost::python::detail::new_reference(PyTuple_New(args->Length)));
+			for (int i = 0; i != args->Length; ++i)
+			{
+				boost::python::object x = DynamicObjectDetail::ConvertToPython(args[i]);
+				PyTuple_SET_ITEM(pyargs.ptr(), i, boost::python::incref(x.ptr()));
+			}
+
+			// Error raised by handler propagates, and remaining invocations stay queued
+			boost::python::handle<> rv(PyObject_CallObject(queued->GetHandler(), pyargs.ptr()));
+		}
+
+		return count;
+	}
+
+	bool DynamicEventQueue::Wait(double timeout)
+	{
+		EventRing ^ring = _ring;
+		int milliseconds = (timeout < 0 ? System::Threading::Timeout::Infinite : (int)(timeout * 1000.0));
+
+		ReleaseGIL lk;
+		return ring->Wait(milliseconds);
+	}
+
+	void DynamicEventQueue::Register(const std::string &name)
+	{
+		using namespace boost::python;
+
+		PYDOTNET_REGISTER_PRINT_DEBUG(name);
+
+		class_<DynamicEventQueue>(name.c_str(), init<int>())
+			.def("bind", &DynamicEventQueue::Bind, "Binds python handler to queue, i.e. obj.Changed += queue.bind(handler)")
+			.def("dispatch", &DynamicEventQueue::Dispatch, (arg("max") = 0), "Calls handlers of pending events, and returns number of events dispatched")
+			.def("wait", &DynamicEventQueue::Wait, (arg("timeout") = -1.0), "Waits with the GIL released until events are pending or queue is closed")
+			.def("close", &DynamicEventQueue::Close, "Stops accepting events")
+			.add_property("capacity", &DynamicEventQueue::GetCapacity)
+			.add_property("closed", &DynamicEventQueue::IsClosed)
+			.add_property("pending", &DynamicEventQueue::GetPending, "Number of events waiting for dispatch")
+			.add_property("enqueued", &DynamicEventQueue::GetEnqueued, "Number of events accepted so far")
+			.add_property("dispatched", &DynamicEventQueue::GetDispatched, "Number of events dispatched so far")
+			.add_property("dropped", &DynamicEventQueue::GetDropped, "Number of events dropped, because queue was full")
+			;
+	}
+
+	boost::python::object DynamicEvent::AddHandler(boost::python::object self, boost::python::object handler)
+	{
+		DynamicEvent &ev = boost::python::extract<DynamicEvent &>(self);
+		System::Reflection::EventInfo ^ei = ev._ei;
+
+		try
+		{
+			EventSubscriptions::Subscription ^subscription;
+
+			boost::python::extract<const DynamicQueuedHandler &> maybeQueued(handler);
+			if (maybeQueued.check())
+			{
+				const DynamicQueuedHandler &queued = maybeQueued;
+				subscription = gcnew EventSubscriptions::Subscription(ei, queued.GetHandler().ptr());
+				subscription->Ring = queued.GetRing();
+				subscription->Delegate = queued.CreateDelegate(ei->EventHandlerType);
+			}
+			else
+			{
+				subscription = gcnew EventSubscriptions::Subscription(ei, handler.ptr());
+				subscription->Delegate = dynamic_cast<System::Delegate ^>(ConvertToManagedObject(handler, ei->EventHandlerType));
+			}
+
+			if (subscription->Delegate == nullptr)
+			{
+				delete subscription;
+				throw_invalid_cast("Cannot convert handler to " + ConvertToUnmanaged(ei->EventHandlerType->FullName));
+				throw std::runtime_error("Invalid cast");
+			}
+
+			System::Object ^obj = ev._obj;
+			ei->AddEventHandler(obj, subscription->Delegate);
+			EventSubscriptions::Add(EventSubscriptions::GetSource(obj, ei), subscription);
+		}
+		PYDOTNET_HANDLE_MANAGED_EXCEPTION(err);
+
+		return self;
+	}
+
+	boost::python::object DynamicEvent::RemoveHandler(boost::python::object self, boost::python::object handler)
+	{
+		DynamicEvent &ev = boost::python::extract<DynamicEvent &>(self);
+		System::Reflection::EventInfo ^ei = ev._ei;
+		System::Object ^obj = ev._obj;
+
+		System::Delegate ^del;
+		try
+		{
+			boost::python::extract<const DynamicQueuedHandler &> maybeQueued(handler);
+			if (maybeQueued.check())
+			{
+				const DynamicQueuedHandler &queued = maybeQueued;
+				del = EventSubscriptions::Remove(EventSubscriptions::GetSource(obj, ei), ei, queued.GetHandler().ptr(), queued.GetRing());
+			}
+			else
+			{
+				del = EventSubscriptions::Remove(EventSubscriptions::GetSource(obj, ei), ei, handler.ptr(), nullptr);
+			}
+
+			if (del != nullptr)
+			{
+				ei->RemoveEventHandler(obj, del);
+			}
+		}
+		PYDOTNET_HANDLE_MANAGED_EXCEPTION(err);
+
+		if (del == nullptr)
+		{
+			throw_value_error("Handler is not subscribed to event " + ConvertToUnmanaged(ei->Name));
+			throw std::runtime_error("Handler is not subscribed to event");
+		}
+
+		return self;
+	}
+
+	boost::python::str DynamicEvent::ToString() const
+	{
+		return boost::python::str("event " + ConvertToUnmanaged(_ei->Name) + ": " + ConvertToUnmanaged(_ei->EventHandlerType->FullName));
+	}
+
+	void DynamicEvent::Register(const std::string &name)
+	{
+		using namespace boost::python;
+
+		PYDOTNET_REGISTER_PRINT_DEBUG(name);
+
+		class_<DynamicEvent>(name.c_str(), no_init)
+			.def("__iadd__", &DynamicEvent::AddHandler, "Subscribes python callable, or handler bound to event queue")
+			.def("__isub__", &DynamicEvent::RemoveHandler, "Unsubscribes handler previously subscribed, or equal to it, and raises ValueError if there is none")
+			.def("__str__", &DynamicEvent::ToString)
+			.def("__repr__", &DynamicEvent::ToString)
+			;
+	}
+
+}// namespace InteropPython
@@ -0,0 +1,156 @@
+// The MIT License (MIT) Copyright (c) 2016, Susquehanna International Group
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "InteropPython.h"
+
+namespace InteropPython {
+
+	// Entry owns python weak reference to wrapper, and it is finalized along with managed 
+	// object it is attached to, which may happen on any thread.
+	ref class IdentityMapEntry sealed
+	{
+	public:
+		IdentityMapEntry(PyObject *weakref) : _weakref(weakref)
+		{
+			DeferredRelease::Adopt(_weakref);
+
+			// Entries are only created with the GIL held, so that peak needs no interlocked update
+			long count = System::Threading::Interlocked::Increment(_count);
+			if (count > _peak)
+			{
+				_peak = count;
+			}
+		}
+
+		~IdentityMapEntry()
+		{
+			this->!IdentityMapEntry();
+		}
+
+		!IdentityMapEntry()
+		{
+			if (_weakref != nullptr)
+			{
+				DeferredRelease::Release(_weakref);
+				_weakref = nullptr;
+				System::Threading::Interlocked::Decrement(_count);
+			}
+		}
+
+		PyObject *GetWeakRef()
+		{
+			return _weakref;
+		}
+
+		static long GetCount()
+		{
+			return _count;
+		}
+
+		static long GetPeakCount()
+		{
+			return _peak;
+		}
+
+	private:
+		PyObject *_weakref;
+		static long _count = 0;
+		static long _peak = 0;
+	};
+
+	ref class IdentityMapEntries abstract sealed
+	{
+	public:
+		static IdentityMapEntry ^Find(System::Object ^obj)
+		{
+			IdentityMapEntry ^entry;
+			return _entries->TryGetValue(obj, entry) ? entry : nullptr;
+		}
+
+		static void Add(System::Object ^obj, IdentityMapEntry ^entry)
+		{
+			// Entry of wrapper no longer alive is replaced, and its weak reference released now
+			IdentityMapEntry ^previous;
+			if (_entries->TryGetValue(obj, previous))
+			{
+				_entries->Remove(obj);
+				delete previous;
+			}
+
+			_entries->Add(obj, entry);
+		}
+
+	private:
+		static IdentityMapEntries()
+		{
+			_entries = gcnew System::Runtime::CompilerServices::ConditionalWeakTable<
+				System::Object ^, IdentityMapEntry ^>();
+		}
+
+		static System::Runtime::CompilerServices::ConditionalWeakTable<
+			System::Object ^, IdentityMapEntry ^> ^_entries;
+	};
+
+	boost::python::object DynamicIdentityMap::Find(System::Object ^obj)
+	{
+		// Boxed values are copied on every conversion, so they have no identity to preserve
+		if (obj == nullptr || obj->GetType()->IsValueType)
+		{
+			return boost::python::object();
+		}
+
+		IdentityMapEntry ^entry = IdentityMapEntries::Find(obj);
+		if (entry == nullptr)
+		{
+			return boost::python::object();
+		}
+
+		// Dead weak reference gives None
+		PyObject *wrapper = PyWeakref_GetObject(entry->GetWeakRef());
+		return boost::python::object(boost::python::handle<>(boost::python::borrowed(wrapper)));
+	}
+
+	void DynamicIdentityMap::Add(System::Object ^obj, const boost::python::object &wrapper)
+	{
+		if (obj == nullptr || obj->GetType()->IsValueType)
+		{
+			return;
+		}
+
+		PyObject *weakref = PyWeakref_NewRef(wrapper.ptr(), nullptr);
+		if (weakref == nullptr)
+		{
+			boost::python::throw_error_already_set();
+		}
+
+		IdentityMapEntries::Add(obj, gcnew IdentityMapEntry(weakref));
+	}
+
+	long DynamicIdentityMap::GetCount()
+	{
+		return IdentityMapEntry::GetCount();
+	}
+
+	long DynamicIdentityMap::GetPeakCount()
+	{
+		return IdentityMapEntry::GetPeakCount();
+	}
+
+}// namespace InteropPython
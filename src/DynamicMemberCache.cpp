@@ -0,0 +1,170 @@
+// The MIT License (MIT) Copyright (c) 2016, Susquehanna International Group
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "InteropPython.h"
+
+namespace InteropPython {
+
+	DynamicMemberCache::Types *DynamicMemberCache::sTypes = nullptr;
+	int DynamicMemberCache::sCount = 0;
+
+	MemberDescriptor::MemberDescriptor(array<MemberInfo ^> ^members) : _members(members), _hasGenericMethods(false)
+	{
+		if (members == nullptr || members->Length == 0)
+		{
+			_kind = Missing;
+		}
+		else if (members[0]->MemberType == System::Reflection::MemberTypes::Method)
+		{
+			_kind = MethodGroup;
+
+			const int n = members->Length;
+			for (int i = 0; i != n; ++i)
+			{
+				MethodInfo ^mi = safe_cast<MethodInfo ^>(members[i]);
+				_methods.push_back(DynamicMethodInvoker(mi, nullptr));
+				_hasGenericMethods |= mi->ContainsGenericParameters;
+			}
+
+			// Overload resolution results are shared by all instances
+			_overloadCache = std::make_shared<OverloadCache>();
+		}
+		else if (members->Length > 1)
+		{
+			_kind = Other;
+		}
+		else if (members[0]->MemberType == System::Reflection::MemberTypes::Property)
+		{
+			_kind = Property;
+		}
+		else if (members[0]->MemberType == System::Reflection::MemberTypes::Field)
+		{
+			_kind = Field;
+		}
+		else if (members[0]->MemberType == System::Reflection::MemberTypes::NestedType)
+		{
+			_kind = NestedType;
+		}
+		else if (members[0]->MemberType == System::Reflection::MemberTypes::Event)
+		{
+			_kind = Event;
+		}
+		else
+		{
+			_kind = Other;
+		}
+	}
+
+	boost::python::object MemberDescriptor::Bind(System::Object ^obj) const
+	{
+		switch (_kind)
+		{
+		case Missing:
+			throw_invalid_attribute();
+			throw std::runtime_error("Invalid attribute");
+
+		case Property:
+			return DoGetProperty(obj, safe_cast<PropertyInfo ^>(_members[0]));
+
+		case Field:
+			return DoGetProperty(obj, safe_cast<FieldInfo ^>(_members[0]));
+
+		case NestedType:
+			if (_unbound.is_none())
+			{
+				_unbound = DoGetProperty(obj, safe_cast<System::Type ^>(_members[0]));
+			}
+			return _unbound;
+
+		case Event:
+			return boost::python::object(DynamicEvent(obj, safe_cast<System::Reflection::EventInfo ^>(_members[0])));
+
+		case MethodGroup:
+			{
+				if (obj == nullptr && !_unbound.is_none())
+				{
+					return _unbound;
+				}
+
+				boost::python::object bound;
+
+				if (_methods.size() == 1)
+				{
+					bound = boost::python::object(_methods[0].Bind(obj));
+				}
+				else
+				{
+					std::vector<DynamicMethodInvoker> methods;
+					methods.reserve(_methods.size());
+
+					for (auto it = _methods.begin(); it != _methods.end(); ++it)
+					{
+						methods.push_back(it->Bind(obj));
+					}
+
+					bound = boost::python::object(DynamicOverloadResolver<DynamicMethodInvoker>(std::move(methods), _overloadCache));
+				}
+
+				if (obj == nullptr)
+				{
+					_unbound = bound;
+				}
+				return bound;
+			}
+
+		default:
+			return DoGetProperty(obj, _members.operator array<MemberInfo ^> ^());
+		}
+	}
+
+	const MemberDescriptor &DynamicMemberCache::Get(System::Type ^typ, const std::string &name)
+	{
+		if (sTypes == nullptr)
+		{
+			// Never freed, as descriptors hold python objects, which must not outlive interpreter
+			sTypes = new Types;
+		}
+
+		TypeMembers &members = (*sTypes)[(intptr_t)typ->TypeHandle.Value.ToPointer()];
+
+		auto pp = members.find(name);
+		if (pp != members.end())
+		{
+			return pp->second;
+		}
+
+		typedef System::Reflection::BindingFlags BindingFlags;
+
+		array<System::Reflection::MemberInfo ^> ^mi = typ->GetMember(ConvertToManagedString(name), BindingFlags::FlattenHierarchy 
+			| BindingFlags::Public
+			| BindingFlags::Instance 
+			| BindingFlags::Static);
+
+		++sCount;
+		return members.insert(std::make_pair(name, MemberDescriptor(mi))).first->second;
+	}
+
+	int DynamicMemberCache::GetCount()
+	{
+		return sCount;
+	}
+
+}// namespace InteropPython
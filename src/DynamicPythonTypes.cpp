@@ -0,0 +1,169 @@
+// The MIT License (MIT) Copyright (c) 2016, Susquehanna International Group
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "InteropPython.h"
+
+namespace InteropPython {
+
+	std::unordered_map<intptr_t, boost::python::object> *DynamicPythonTypes::sTypes = nullptr;
+
+	boost::python::object MemberAccessor::Get(boost::python::object obj, boost::python::object type) const
+	{
+		if (obj.is_none())
+		{
+			return boost::python::object(*this);
+		}
+
+		const DynamicObjectHandle &handle = boost::python::extract<const DynamicObjectHandle &>(obj);
+
+		try
+		{
+			return _member->Bind(handle.GetObject());
+		}
+		PYDOTNET_HANDLE_MANAGED_EXCEPTION(err);
+	}
+
+	void DataMemberAccessor::Set(boost::python::object obj, boost::python::object value) const
+	{
+		DynamicObjectHandle &handle = boost::python::extract<DynamicObjectHandle &>(obj);
+		handle.SetProperty(_name.c_str(), value);
+	}
+
+	void MemberAccessor::Register(const std::string &name, const std::string &dataName)
+	{
+		using namespace boost::python;
+
+		PYDOTNET_REGISTER_PRINT_DEBUG(name);
+
+		class_<MemberAccessor>(name.c_str(), no_init)
+			.add_property("Name", &MemberAccessor::GetName, "Name")
+			.def("__get__", &MemberAccessor::Get)
+			;
+
+		PYDOTNET_REGISTER_PRINT_DEBUG(dataName);
+
+		// Having __set__ makes it data descriptor, which takes precedence over instance __dict__
+		class_<DataMemberAccessor, bases<MemberAccessor> >(dataName.c_str(), no_init)
+			.def("__set__", &DataMemberAccessor::Set)
+			;
+	}
+
+	boost::python::object DynamicPythonTypes::GetType(System::Type ^typ)
+	{
+		if (sTypes == nullptr)
+		{
+			// Never freed, as types must not outlive interpreter
+			sTypes = new std::unordered_map<intptr_t, boost::python::object>;
+		}
+
+		intptr_t key = (intptr_t)typ->TypeHandle.Value.ToPointer();
+
+		auto pp = sTypes->find(key);
+		if (pp != sTypes->end())
+		{
+			return pp->second;
+		}
+
+		typedef System::Reflection::BindingFlags BindingFlags;
+
+		array<System::Reflection::MemberInfo ^> ^members = typ->GetMembers(BindingFlags::FlattenHierarchy
+			| BindingFlags::Public
+			| BindingFlags::Instance
+			| BindingFlags::Static);
+
+		std::set<std::string> names;
+
+		for (int i = 0; i != members->Length; ++i)
+		{
+			System::Reflection::MemberInfo ^mi = members[i];
+			System::Reflection::MethodBase ^mb = dynamic_cast<System::Reflection::MethodBase ^>(mi);
+
+			// Skip constructors and property / event accessors
+			if (mb != nullptr && (mb->IsConstructor || mb->IsSpecialName))
+			{
+				continue;
+			}
+
+			std::string name = ConvertToUnmanaged(mi->Name);
+			if (!boost::algorithm::starts_with(name, "__"))
+			{
+				names.insert(name);
+			}
+		}
+
+		boost::python::dict ns;
+		ns["__module__"] = typ->Namespace != nullptr ? ConvertToUnmanaged(typ->Namespace) : std::string();
+
+		for (auto it = names.begin(); it != names.end(); ++it)
+		{
+			const MemberDescriptor &member = DynamicMemberCache::Get(typ, *it);
+
+			switch (member.GetKind())
+			{
+			case MemberDescriptor::Property:
+			case MemberDescriptor::Field:
+				ns[*it] = boost::python::object(DataMemberAccessor(&member, *it));
+				break;
+
+			case MemberDescriptor::MethodGroup:
+				if (!member.HasGenericMethods())
+				{
+					ns[*it] = boost::python::object(MemberAccessor(&member, *it));
+				}
+				break;
+
+			case MemberDescriptor::Missing:
+				break;
+
+			default:
+				ns[*it] = boost::python::object(MemberAccessor(&member, *it));
+				break;
+			}
+		}
+
+		PyTypeObject *base = boost::python::converter::registered<DynamicObjectHandle>::converters.get_class_object();
+		boost::python::object baseClass(boost::python::handle<>(boost::python::borrowed((PyObject *)base)));
+		boost::python::object metaClass(boost::python::handle<>(boost::python::borrowed((PyObject *)Py_TYPE(base))));
+
+		// Arrays exporting buffers derive from Interop.Array, which carries buffer protocol
+		if (DynamicBuffer::Exports(typ))
+		{
+			baseClass = DynamicBuffer::GetArrayClass();
+		}
+
+		boost::python::object cls = metaClass(ConvertToUnmanaged(typ->Name), boost::python::make_tuple(baseClass), ns);
+		sTypes->insert(std::make_pair(key, cls));
+		return cls;
+	}
+
+	void DynamicPythonTypes::Assign(boost::python::object &obj, System::Type ^typ)
+	{
+		boost::python::object cls = GetType(typ);
+
+		// Plain setattr would end up in Interop.Object.__setattr__, which sets managed properties
+		boost::python::str attr("__class__");
+		if (PyObject_GenericSetAttr(obj.ptr(), attr.ptr(), cls.ptr()) != 0)
+		{
+			boost::python::throw_error_already_set();
+		}
+	}
+
+}// namespace InteropPython
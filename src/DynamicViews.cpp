@@ -0,0 +1,152 @@
+// The MIT License (MIT) Copyright (c) 2016, Susquehanna International Group
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "InteropPython.h"
+
+namespace InteropPython {
+
+	System::Exception ^ PythonObjectView::FetchError()
+	{
+		PyObject *type, *value, *traceback;
+		PyErr_Fetch(&type, &value, &traceback);
+
+		System::String ^message = "Python error";
+		if (value != nullptr)
+		{
+			PyObject *text = PyObject_Str(value);
+			if (text != nullptr)
+			{
+				message = ConvertToManagedString(boost::python::object(boost::python::handle<>(text)));
+			}
+			else
+			{
+				PyErr_Clear();
+			}
+		}
+
+		Py_XDECREF(type);
+		Py_XDECREF(value);
+		Py_XDECREF(traceback);
+		return gcnew System::InvalidOperationException(message);
+	}
+
+	System::Object ^ PythonObjectView::ConvertToManaged(PyObject *item, System::Type ^typ)
+	{
+		try
+		{
+			// Items of mapping are (key, value) tuples
+			if (typ->IsGenericType && PyTuple_Check(item) && PyTuple_GET_SIZE(item) == 2 && 
+				typ->GetGenericTypeDefinition()->Equals(
+					System::Collections::Generic::KeyValuePair<System::Object ^, System::Object ^>::typeid->GetGenericTypeDefinition()))
+			{
+				array<System::Type ^> ^genericArgs = typ->GetGenericArguments();
+				System::Object ^key = ConvertToManaged(PyTuple_GET_ITEM(item, 0), genericArgs[0]);
+				System::Object ^value = ConvertToManaged(PyTuple_GET_ITEM(item, 1), genericArgs[1]);
+				return System::Activator::CreateInstance(typ, gcnew array<System::Object ^> { key, value });
+			}
+
+			boost::python::object obj(boost::python::handle<>(boost::python::borrowed(item)));
+			return DynamicObjectDetail::ConvertToManaged(obj, typ);
+		}
+		catch (const boost::python::error_already_set &)
+		{
+			throw FetchError();
+		}
+	}
+
+	PyObject * PythonObjectView::ConvertToPython(System::Object ^value)
+	{
+		try
+		{
+			boost::python::object obj = DynamicObjectDetail::ConvertToPython(value);
+			return boost::python::incref(obj.ptr());
+		}
+		catch (const boost::python::error_already_set &)
+		{
+			throw FetchError();
+		}
+	}
+
+	System::Type ^ DynamicView::GetViewType(System::Type ^resultType)
+	{
+		if (!resultType->IsInterface || !resultType->IsGenericType || resultType->ContainsGenericParameters)
+		{
+			return nullptr;
+		}
+
+		array<System::Type ^> ^genericArgs = resultType->GetGenericArguments();
+		System::Type ^viewType = nullptr;
+
+		if (genericArgs->Length == 1)
+		{
+			viewType = PythonSequenceView<System::Object ^>::typeid->GetGenericTypeDefinition()->MakeGenericType(genericArgs);
+		}
+		else if (genericArgs->Length == 2)
+		{
+			viewType = PythonMappingView<System::Object ^, System::Object ^>::typeid->GetGenericTypeDefinition()->MakeGenericType(genericArgs);
+		}
+
+		if (viewType == nullptr || !resultType->IsAssignableFrom(viewType))
+		{
+			return nullptr;
+		}
+		return viewType;
+	}
+
+	bool DynamicView::Supports(System::Type ^resultType, PyObject *obj)
+	{
+		// Lists are mappings too in Python 3, but dicts are never sequences
+		if (resultType->GetGenericArguments()->Length == 2)
+		{
+			return PyMapping_Check(obj) && !PySequence_Check(obj);
+		}
+
+		// Enumerating needs only iterator, while other interfaces index into sequence
+		if (resultType->GetGenericTypeDefinition()->Equals(
+			System::Collections::Generic::IEnumerable<System::Object ^>::typeid->GetGenericTypeDefinition()))
+		{
+			return Py_TYPE(obj)->tp_iter != nullptr || PySequence_Check(obj);
+		}
+		return PySequence_Check(obj) != 0;
+	}
+
+	System::Object ^ DynamicView::CreateView(System::Type ^resultType) const
+	{
+		System::Type ^viewType = GetViewType(resultType);
+		if (viewType == nullptr || !Supports(resultType, _obj.ptr()))
+		{
+			return nullptr;
+		}
+		return System::Activator::CreateInstance(viewType, gcnew array<System::Object ^> { System::IntPtr(_obj.ptr()) });
+	}
+
+	void DynamicView::Register(const std::string &name)
+	{
+		using namespace boost::python;
+
+		PYDOTNET_REGISTER_PRINT_DEBUG(name);
+
+		class_<DynamicView>(name.c_str(), init<object>())
+			.add_property("Source", &DynamicView::GetObject, "Python sequence or mapping viewed")
+			;
+	}
+
+}// namespace InteropPython
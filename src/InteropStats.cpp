@@ -0,0 +1,136 @@
+// The MIT License (MIT) Copyright (c) 2016, Susquehanna International Group
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of
+// this software and associated documentation files (the "Software"), to deal in
+// the Software without restriction, including without limitation the rights to
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+// of the Software, and to permit persons to whom the Software is furnished to do
+// so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "InteropPython.h"
+
+namespace InteropPython {
+
+	// Source line of python code running on this thread
+	ref class PythonSite abstract sealed
+	{
+	public:
+		// Returns nullptr when this thread does not hold the GIL, as python cannot be touched then
+		static System::String ^ Current()
+		{
+			if (!Py_IsInitialized() || !HoldsGIL() || PyErr_Occurred() != nullptr)
+			{
+				return nullptr;
+			}
+
+			PyObject *frame = (PyObject *)PyEval_GetFrame();
+			if (frame == nullptr)
+			{
+				return nullptr;
+			}
+
+			try
+			{
+				boost::python::object f(boost::python::handle<>(boost::python::borrowed(frame)));
+				boost::python::object code = f.attr("f_code");
+				std::string file = boost::python::extract<std::string>(code.attr("co_filename"));
+				std::string func = boost::python::extract<std::string>(code.attr("co_name"));
+				int line = boost::python::extract<int>(f.attr("f_lineno"));
+				return ConvertToManagedString(file + ":" + std::to_string(line) + " in " + func);
+			}
+			catch (const boost::python::error_already_set &)
+			{
+				PyErr_Clear();
+				return nullptr;
+			}
+		}
+
+	private:
+		static bool HoldsGIL()
+		{
+#if PY_VERSION_HEX >= 0x03040000
+			return PyGILState_Check() != 0;
+#else
+			PyThreadState *state = PyGILState_GetThisThreadState();
+			return state != nullptr && state == _PyThreadState_Current;
+#endif
+		}
+	};
+
+	boost::python::dict InteropStats::GetStats()
+	{
+		using namespace boost::python;
+
+		dict stats;
+
+		// References held across the boundary
+		stats["handles"] = HandleTable::GetCount();
+		stats["handles_peak"] = HandleTable::GetPeakCount();
+		stats["handle_slots"] = HandleTable::GetCapacity();
+		stats["python_references"] = DeferredRelease::GetHeldCount();
+		stats["python_references_peak"] = DeferredRelease::GetHeldPeakCount();
+		stats["python_references_pending"] = DeferredRelease::GetPendingCount();
+		stats["pinned_arrays"] = DynamicBuffer::GetPinnedCount();
+		stats["pinned_arrays_peak"] = DynamicBuffer::GetPinnedPeakCount();
+		stats["identity_map"] = DynamicIdentityMap::GetCount();
+		stats["identity_map_peak"] = DynamicIdentityMap::GetPeakCount();
+
+		// Caches
+		stats["member_descriptors"] = DynamicMemberCache::GetCount();
+		stats["overload_caches"] = OverloadCache::GetCount();
+		stats["overload_cache_entries"] = OverloadCache::GetEntryCount();
+		stats["call_plans"] = CallPlan::GetCount();
+		stats["compiled_invokers"] = CompiledInvokers::GetCount();
+		stats["python_types"] = DynamicPythonTypes::GetCount();
+
+		const DynamicTypesCache &types = DynamicTypesCache::GetInstance();
+		stats["cached_types"] = types.Types.size();
+		stats["cached_namespaces"] = types.Namespaces.size();
+		stats["cached_assemblies"] = types.Assemblies.size();
+
+		// Managed heap
+		stats["managed_heap"] = (long long)System::GC::GetTotalMemory(false);
+
+		list collections;
+		for (int generation = 0; generation <= System::GC::MaxGeneration; ++generation)
+		{
+			collections.append(System::GC::CollectionCount(generation));
+		}
+		stats["gc_collections"] = collections;
+
+		if (HandleTable::IsTrackingSites())
+		{
+			dict sites;
+			for each (System::Collections::Generic::KeyValuePair<System::String ^, int> site in HandleTable::GetSites())
+			{
+				sites[ConvertToUnmanaged(site.Key)] = site.Value;
+			}
+			stats["handle_sites"] = sites;
+		}
+
+		return stats;
+	}
+
+	bool InteropStats::GetTrackHandleSites()
+	{
+		return HandleTable::IsTrackingSites();
+	}
+
+	void InteropStats::SetTrackHandleSites(bool enabled)
+	{
+		// Handles allocated while not tracked are not listed, and so only leaks from now on are found
+		HandleTable::TrackSites(enabled ? gcnew System::Func<System::String ^>(&PythonSite::Current) : nullptr);
+	}
+
+}// namespace InteropPython